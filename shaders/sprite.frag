@@ -0,0 +1,17 @@
+// shaders/sprite.frag - Textured, tinted sprite fragment for the SDL_GPU backend
+//
+// Compile with: glslc sprite.frag -o sprite.frag.spv
+// Fragment samplers live in set 2 (see SDL_CreateGPUShader()).
+#version 450
+
+layout(set = 2, binding = 0) uniform sampler2D spriteTexture;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    outColor = texture(spriteTexture, inUV) * inColor;
+}
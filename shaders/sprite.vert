@@ -0,0 +1,50 @@
+// shaders/sprite.vert - Instanced sprite quads for the SDL_GPU backend
+//
+// Compile with: glslc sprite.vert -o sprite.vert.spv
+// Resource sets follow SDL_CreateGPUShader(): vertex storage buffers in
+// set 0, vertex uniforms in set 1.
+#version 450
+
+// Must match GpuSpriteInstance in src/gpu_renderer.h
+struct SpriteInstance
+{
+    vec4 dst;   // x, y, w, h in view pixels
+    vec4 uv;    // u0, v0, u1, v1
+    vec4 rot;   // cos(angle), sin(angle), unused, unused
+    vec4 color; // RGBA multiplier
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Instances
+{
+    SpriteInstance sprites[];
+};
+
+layout(set = 1, binding = 0) uniform Frame
+{
+    vec2 viewToNdc; // 2 / view size
+    vec2 unused;
+};
+
+layout(location = 0) out vec2 outUV;
+layout(location = 1) out vec4 outColor;
+
+const vec2 kCorners[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0));
+
+void main()
+{
+    SpriteInstance s = sprites[gl_InstanceIndex];
+    vec2 corner = kCorners[gl_VertexIndex];
+
+    // Rotate around the sprite centre, like SDL_RenderTextureRotated
+    vec2 local   = (corner - 0.5) * s.dst.zw;
+    vec2 rotated = vec2(local.x * s.rot.x - local.y * s.rot.y,
+                        local.x * s.rot.y + local.y * s.rot.x);
+    vec2 pos     = s.dst.xy + 0.5 * s.dst.zw + rotated;
+
+    // View is y-down from the top-left; NDC is y-up
+    gl_Position = vec4(pos.x * viewToNdc.x - 1.0, 1.0 - pos.y * viewToNdc.y, 0.0, 1.0);
+    outUV    = mix(s.uv.xy, s.uv.zw, corner);
+    outColor = s.color;
+}
@@ -0,0 +1,250 @@
+// src/asset_loader.cpp - Asynchronous asset loading: SDL_AsyncIO reads, worker decodes
+#include "asset_loader.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "png_decoder.h"
+
+static const char* const kCookedExt    = ".tex";
+static const char* const kSourceExts[] = { ".png", ".bmp" }; // preferred first
+
+AssetLoader::AssetLoader(const AssetPack* pack, const std::string& looseDir)
+    : pack_(pack)
+    , looseDir_(looseDir)
+{
+    queue_ = SDL_CreateAsyncIOQueue();
+    if (!queue_) {
+        std::cerr << "Assets: SDL_CreateAsyncIOQueue failed: " << SDL_GetError()
+                  << " - loading synchronously.\n";
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    if (!workers_.empty()) {
+        SDL_LockMutex(mutex_);
+        quit_ = true;
+        SDL_BroadcastCondition(wake_);
+        SDL_UnlockMutex(mutex_);
+        for (SDL_Thread* t : workers_) SDL_WaitThread(t, nullptr);
+    }
+    for (const DecodeJob& job : jobs_) {
+        if (job.owned) SDL_free(job.data);
+    }
+    for (const Decoded& d : decoded_) SDL_DestroySurface(d.surf);
+
+    // Reads still in flight own buffers that only we can free
+    SDL_AsyncIOOutcome outcome;
+    while (inFlight_ > 0 && SDL_WaitAsyncIOResult(queue_, &outcome, -1)) {
+        SDL_free(outcome.buffer);
+        --inFlight_;
+    }
+    if (queue_) SDL_DestroyAsyncIOQueue(queue_);
+
+    if (wake_)  SDL_DestroyCondition(wake_);
+    if (mutex_) SDL_DestroyMutex(mutex_);
+}
+
+bool AssetLoader::Start(int workers)
+{
+    if (!workers_.empty()) return true;
+    if (workers <= 0) workers = std::clamp(SDL_GetNumLogicalCPUCores() - 1, 1, 4);
+
+    mutex_ = SDL_CreateMutex();
+    wake_  = SDL_CreateCondition();
+    for (int i = 0; mutex_ && wake_ && i < workers; ++i) {
+        SDL_Thread* t = SDL_CreateThread(WorkerMain, "asset-decode", this);
+        if (!t) break;
+        workers_.push_back(t);
+    }
+    if (workers_.empty()) {
+        std::cerr << "Assets: cannot start decode threads: " << SDL_GetError()
+                  << " - decoding on the render thread.\n";
+        return false;
+    }
+    return true;
+}
+
+// The first source format on disk, or the preferred one's path (which then
+// fails to read) if there's none
+static std::string LooseSourcePath(const std::string& stem)
+{
+    for (const char* ext : kSourceExts) {
+        if (SDL_GetPathInfo((stem + ext).c_str(), nullptr)) return stem + ext;
+    }
+    return stem + kSourceExts[0];
+}
+
+// PNG to an RGBA32 surface (bytes R, G, B, A) with the in-tree decoder
+static SDL_Surface* LoadPNG(const void* data, size_t size)
+{
+    PngInfo     info;
+    std::string error;
+    if (ReadPngInfo(data, size, info, error)) {
+        SDL_Surface* surf = SDL_CreateSurface((int)info.width, (int)info.height, SDL_PIXELFORMAT_RGBA32);
+        if (!surf) return nullptr;
+        if (DecodePng(data, size, (Uint8*)surf->pixels, (size_t)surf->pitch, error)) return surf;
+        SDL_DestroySurface(surf);
+    }
+    SDL_SetError("%s", error.c_str());
+    return nullptr;
+}
+
+void AssetLoader::Load(const std::string& name, OnLoaded onLoaded)
+{
+    const size_t index = requests_.size();
+    requests_.push_back(Request{ {}, std::move(onLoaded), SDL_GetTicksNS() }); // path: below
+    if (firstStartNS_ == 0) firstStartNS_ = requests_.back().startNS;
+    ++pending_;
+
+    // Packed: already in memory, straight to a decoder
+    size_t size = 0;
+    for (const char* ext : { kCookedExt, kSourceExts[0], kSourceExts[1] }) {
+        const void* packed = pack_ ? pack_->Find(name + ext, size) : nullptr;
+        if (packed) {
+            ++fromPack_;
+            Queue(DecodeJob{ index, (void*)packed, size, name + ext, false });
+            return;
+        }
+    }
+
+    const std::string path = LooseSourcePath(looseDir_ + name);
+    requests_[index].path = path;
+
+    if (queue_ && SDL_LoadFileAsync(path.c_str(), queue_, (void*)(uintptr_t)index)) {
+        ++inFlight_;
+        return;
+    }
+
+    // No async I/O: read now, still decode off this thread if possible
+    void* data = SDL_LoadFile(path.c_str(), &size);
+    if (!data) {
+        std::cerr << "Assets: cannot read '" << path << "': " << SDL_GetError() << "\n";
+        Finish(index, nullptr);
+        return;
+    }
+    bytesRead_ += size;
+    Queue(DecodeJob{ index, data, size, path });
+}
+
+void AssetLoader::Queue(DecodeJob job)
+{
+    if (workers_.empty()) {
+        ImageMeta meta;
+        SDL_Surface* surf = Decode(job, meta);
+        Finish(job.request, surf, meta);
+        return;
+    }
+    SDL_LockMutex(mutex_);
+    jobs_.push_back(std::move(job));
+    SDL_SignalCondition(wake_);
+    SDL_UnlockMutex(mutex_);
+}
+
+SDL_Surface* AssetLoader::Decode(const DecodeJob& job, ImageMeta& meta)
+{
+    SDL_Surface* surf = nullptr;
+    if (IsCookedTexture(job.data, job.size)) {
+        surf = CookedTextureSurface(job.data, job.size, meta);
+        if (surf && job.owned) {
+            // Only pack memory outlives the job; keep a copy of the rest
+            SDL_Surface* copy = SDL_DuplicateSurface(surf);
+            SDL_DestroySurface(surf);
+            surf = copy;
+        }
+    } else if (IsPng(job.data, job.size)) {
+        surf = LoadPNG(job.data, job.size);
+    } else {
+        SDL_IOStream* io = SDL_IOFromConstMem(job.data, job.size);
+        surf = io ? SDL_LoadBMP_IO(io, true) : nullptr;
+    }
+    if (!surf) {
+        std::cerr << "Assets: cannot decode '" << job.path << "': " << SDL_GetError() << "\n";
+    }
+    if (job.owned) SDL_free(job.data);
+    return surf;
+}
+
+int AssetLoader::WorkerMain(void* self)
+{
+    AssetLoader& loader = *(AssetLoader*)self;
+
+    SDL_LockMutex(loader.mutex_);
+    for (;;) {
+        while (!loader.quit_ && loader.jobs_.empty()) {
+            SDL_WaitCondition(loader.wake_, loader.mutex_);
+        }
+        if (loader.quit_) break;
+
+        DecodeJob job = std::move(loader.jobs_.front());
+        loader.jobs_.pop_front();
+
+        SDL_UnlockMutex(loader.mutex_);
+        ImageMeta meta;
+        SDL_Surface* surf = Decode(job, meta);
+        SDL_LockMutex(loader.mutex_);
+
+        loader.decoded_.push_back(Decoded{ job.request, surf, meta });
+    }
+    SDL_UnlockMutex(loader.mutex_);
+    return 0;
+}
+
+void AssetLoader::Finish(size_t request, SDL_Surface* surf, const ImageMeta& meta)
+{
+    if (surf) ++loaded_;
+    else      ++failed_;
+    if (surf && meta.premultiplied) ++cooked_;
+    --pending_;
+    lastDoneNS_ = SDL_GetTicksNS();
+
+    // The callback may queue more loads, which can grow requests_
+    OnLoaded onLoaded = std::move(requests_[request].onLoaded);
+    onLoaded(surf, meta);
+}
+
+void AssetLoader::Update()
+{
+    // Finished reads go to the decoders
+    SDL_AsyncIOOutcome outcome;
+    while (inFlight_ > 0 && SDL_GetAsyncIOResult(queue_, &outcome)) {
+        --inFlight_;
+        const size_t index = (size_t)(uintptr_t)outcome.userdata;
+        const std::string& path = requests_[index].path;
+        if (outcome.result != SDL_ASYNCIO_COMPLETE) {
+            // SDL_GetError() here would describe this thread's last error, not the read
+            std::cerr << "Assets: cannot read '" << path << "': "
+                      << (outcome.result == SDL_ASYNCIO_CANCELED ? "canceled" : "I/O failure")
+                      << "\n";
+            SDL_free(outcome.buffer);
+            Finish(index, nullptr);
+            continue;
+        }
+        bytesRead_ += outcome.bytes_transferred;
+        Queue(DecodeJob{ index, outcome.buffer, (size_t)outcome.bytes_transferred, path });
+    }
+
+    // Decoded images go to their callbacks, on this thread
+    if (workers_.empty()) return;
+    std::vector<Decoded> ready;
+    SDL_LockMutex(mutex_);
+    ready.swap(decoded_);
+    SDL_UnlockMutex(mutex_);
+    for (const Decoded& d : ready) Finish(d.request, d.surf, d.meta);
+}
+
+void AssetLoader::Report() const
+{
+    if (requests_.empty()) return;
+
+    std::cout << "Assets: " << loaded_ << " loaded, " << failed_ << " failed, "
+              << pending_ << " pending (" << fromPack_ << " from the pack, "
+              << cooked_ << " cooked, "
+              << bytesRead_ / 1024 << " KiB of loose files)";
+    if (pending_ == 0 && lastDoneNS_ > firstStartNS_) {
+        std::cout << ", all done " << (double)(lastDoneNS_ - firstStartNS_) / 1e6
+                  << " ms after the first request";
+    }
+    std::cout << "\n";
+}
@@ -0,0 +1,110 @@
+// src/asset_loader.h - Asynchronous asset loading: SDL_AsyncIO reads, worker decodes
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "asset_pack.h"
+#include "cooked_texture.h"
+
+// Loads images without blocking the render thread. Files are read with
+// SDL_LoadFileAsync into one SDL_AsyncIOQueue, decoded on worker threads,
+// and handed back through a callback from Update(), which the render
+// thread calls once a frame - so textures are created on the thread that
+// owns the renderer, as results arrive. Until then the scene draws its
+// usual placeholders.
+// Assets in the pack skip the read: the decoders parse them straight from
+// its mapping. Anything else is read as a loose file from `looseDir`.
+// Assets are named without an extension. A cooked blob ("<name>.tex", see
+// cooked_texture.h) wins over the source image and needs no decoding: its
+// surface points at the pack's pixels. Source images are PNGs (decoded by
+// png_decoder.h, into RGBA32) or, failing that, BMPs.
+class AssetLoader
+{
+public:
+    // Receives the decoded image, or nullptr if reading or decoding
+    // failed. The callee owns the surface.
+    using OnLoaded = std::function<void(SDL_Surface* surf, const ImageMeta& meta)>;
+
+    // The pack is optional and must outlive the loader.
+    AssetLoader(const AssetPack* pack, const std::string& looseDir);
+    ~AssetLoader(); // waits for reads in flight and discards their results
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Start `workers` decode threads (0 = one per spare core, at most 4).
+    // Without them, Update() decodes on the calling thread.
+    bool Start(int workers = 0);
+
+    // Queue an image by asset name ("wall"). `onLoaded` runs later, from
+    // Update().
+    void Load(const std::string& name, OnLoaded onLoaded);
+
+    // Collect finished reads for the decoders and run the callbacks of
+    // decoded images. Never waits.
+    void Update();
+
+    // Requests whose callback hasn't run yet
+    int Pending() const { return pending_; }
+
+    // Print a one-line summary (assets, bytes, time to the last one) to stdout.
+    void Report() const;
+
+private:
+    struct Request
+    {
+        std::string path; // loose file read, if not from the pack
+        OnLoaded    onLoaded;
+        Uint64      startNS = 0;
+    };
+
+    // A file read, waiting for or going through a decoder
+    struct DecodeJob
+    {
+        size_t      request;
+        void*       data; // SDL_malloc'd by SDL_LoadFileAsync, unless in the pack
+        size_t      size;
+        std::string path; // for error messages
+        bool        owned = true;
+    };
+
+    struct Decoded
+    {
+        size_t       request;
+        SDL_Surface* surf;
+        ImageMeta    meta;
+    };
+
+    static int WorkerMain(void* self);
+    static SDL_Surface* Decode(const DecodeJob& job, ImageMeta& meta); // frees owned job.data
+    void Queue(DecodeJob job);
+    void Finish(size_t request, SDL_Surface* surf, const ImageMeta& meta = ImageMeta{});
+
+    const AssetPack*     pack_;
+    std::string          looseDir_;
+    SDL_AsyncIOQueue*    queue_    = nullptr;
+    int                  inFlight_ = 0; // reads not yet collected from queue_
+    int                  pending_  = 0;
+    std::vector<Request> requests_;     // render thread only
+
+    // Decode workers: jobs in, surfaces out, both under mutex_
+    std::vector<SDL_Thread*> workers_;
+    SDL_Mutex*               mutex_ = nullptr;
+    SDL_Condition*           wake_  = nullptr;
+    bool                     quit_  = false;
+    std::deque<DecodeJob>    jobs_;
+    std::vector<Decoded>     decoded_;
+
+    // Stats
+    Uint64 firstStartNS_ = 0;
+    Uint64 lastDoneNS_   = 0;
+    Uint64 bytesRead_    = 0;
+    int    loaded_       = 0;
+    int    fromPack_     = 0;
+    int    cooked_       = 0;
+    int    failed_       = 0;
+};
@@ -0,0 +1,161 @@
+// src/asset_pack.cpp - Packed asset archive: hashed table of contents, memory-mapped
+#include "asset_pack.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef SDL_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ------------------------------------------------------------
+// Mapping: the file's pages are loaded on first touch and shared with
+// the OS file cache, so opening a pack reads nothing but the header
+// ------------------------------------------------------------
+
+#ifdef SDL_PLATFORM_WINDOWS
+static const Uint8* MapFile(const std::string& path, size_t& size)
+{
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring wpath(wlen > 0 ? (size_t)wlen : 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wpath[0], wlen);
+
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER length;
+    const Uint8* view = nullptr;
+    if (GetFileSizeEx(file, &length) && length.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = (const Uint8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // the view keeps it alive
+        }
+        size = (size_t)length.QuadPart;
+    }
+    CloseHandle(file);
+    return view;
+}
+
+static void UnmapFile(const Uint8* base, size_t)
+{
+    UnmapViewOfFile(base);
+}
+#else
+static const Uint8* MapFile(const std::string& path, size_t& size)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        size = (size_t)st.st_size;
+        view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // the mapping keeps the file open
+    return view != MAP_FAILED ? (const Uint8*)view : nullptr;
+}
+
+static void UnmapFile(const Uint8* base, size_t size)
+{
+    munmap((void*)base, size);
+}
+#endif
+
+// ------------------------------------------------------------
+// AssetPack
+// ------------------------------------------------------------
+
+bool AssetPack::Open(const std::string& path)
+{
+    Close();
+    path_ = path;
+
+    base_ = MapFile(path, size_);
+    mapped_ = base_ != nullptr;
+    if (!base_) {
+        // No mapping (or an odd file system): one read of the whole pack
+        base_ = (const Uint8*)SDL_LoadFile(path.c_str(), &size_);
+        if (!base_) return false; // no pack is not an error; callers fall back
+    }
+
+    // Everything Find() relies on, checked once here
+    header_ = (const PackHeader*)base_;
+    const char* problem = nullptr;
+    if (size_ < sizeof(PackHeader) || std::memcmp(header_->magic, kPackMagic, 4) != 0) {
+        problem = "not an asset pack";
+    } else if (header_->version != kPackVersion) {
+        problem = "unsupported version";
+    } else if (header_->fileSize != size_ ||
+               sizeof(PackHeader) + (Uint64)header_->slotCount * sizeof(PackSlot) > size_) {
+        problem = "truncated";
+    } else if (header_->slotCount == 0 || (header_->slotCount & (header_->slotCount - 1)) != 0) {
+        problem = "bad table size";
+    }
+    if (problem) {
+        std::cerr << "Asset pack '" << path << "': " << problem << ", ignored.\n";
+        Close();
+        return false;
+    }
+
+    slots_ = (const PackSlot*)(base_ + sizeof(PackHeader));
+    return true;
+}
+
+void AssetPack::Close()
+{
+    if (base_) {
+        if (mapped_) UnmapFile(base_, size_);
+        else         SDL_free((void*)base_);
+    }
+    base_   = nullptr;
+    size_   = 0;
+    header_ = nullptr;
+    slots_  = nullptr;
+    mapped_ = false;
+}
+
+const void* AssetPack::Find(const std::string& name, size_t& size) const
+{
+    if (!slots_) return nullptr;
+
+    const Uint64 hash = AssetPackHash(name.data(), name.size());
+    const Uint32 mask = header_->slotCount - 1;
+    for (Uint32 i = (Uint32)hash & mask, probes = 0; probes <= mask; i = (i + 1) & mask, ++probes) {
+        const PackSlot& slot = slots_[i];
+        if (slot.hash == 0) return nullptr;
+        if (slot.hash != hash || slot.nameLength != name.size()) continue;
+
+        // Same hash: make sure it's the same name, and in bounds
+        if ((Uint64)slot.nameOffset + slot.nameLength > size_) return nullptr;
+        const char* stored = (const char*)base_ + slot.nameOffset;
+        bool same = true;
+        for (size_t c = 0; same && c < name.size(); ++c) {
+            same = stored[c] == AssetPackNormalize(name[c]);
+        }
+        if (!same) continue;
+
+        if (slot.offset > size_ || slot.size > size_ - slot.offset) {
+            std::cerr << "Asset pack '" << path_ << "': entry '" << name << "' out of bounds.\n";
+            return nullptr;
+        }
+        size = (size_t)slot.size;
+        return base_ + slot.offset;
+    }
+    return nullptr;
+}
+
+SDL_IOStream* AssetPack::OpenIO(const std::string& name) const
+{
+    size_t size = 0;
+    const void* data = Find(name, size);
+    return data ? SDL_IOFromConstMem(data, size) : nullptr;
+}
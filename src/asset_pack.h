@@ -0,0 +1,93 @@
+// src/asset_pack.h - Packed asset archive: hashed table of contents, memory-mapped
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+
+// File layout (little-endian), written by tools/pack_assets.cpp:
+//
+//   PackHeader
+//   PackSlot[slotCount]  open-addressed hash table, hash 0 = empty slot
+//   names                the entry names, not terminated
+//   data                 each entry 16-byte aligned
+//
+// Names are normalised (lower case, '/' separators) before hashing, so
+// lookups don't depend on how the file system spells them. slotCount is a
+// power of two at least twice the entry count; a lookup starts at
+// hash & (slotCount - 1) and probes linearly to the next empty slot.
+struct PackHeader
+{
+    char   magic[4];   // kPackMagic
+    Uint32 version;    // kPackVersion
+    Uint32 slotCount;
+    Uint32 entryCount;
+    Uint64 fileSize;   // catches truncated packs
+};
+
+struct PackSlot
+{
+    Uint64 hash;       // AssetPackHash(name), never 0
+    Uint64 offset;     // from the start of the file
+    Uint64 size;
+    Uint32 nameOffset; // from the start of the file
+    Uint32 nameLength;
+};
+
+constexpr char   kPackMagic[4] = { 'F', 'M', 'P', 'K' };
+constexpr Uint32 kPackVersion  = 1;
+constexpr Uint64 kPackAlign    = 16;
+
+inline char AssetPackNormalize(char c)
+{
+    if (c == '\\') return '/';
+    if (c >= 'A' && c <= 'Z') return (char)(c - 'A' + 'a');
+    return c;
+}
+
+// 64-bit FNV-1a of the normalised name
+inline Uint64 AssetPackHash(const char* name, size_t length)
+{
+    Uint64 h = 14695981039346656037ull;
+    for (size_t i = 0; i < length; ++i) {
+        h ^= (Uint8)AssetPackNormalize(name[i]);
+        h *= 1099511628211ull;
+    }
+    return h != 0 ? h : 1;
+}
+
+// A read-only view of a pack file. Open() maps the file and checks the
+// header; it doesn't read or index the table, so it costs the same for
+// any number of assets. Find() hashes the name and probes the table in
+// the mapping. Entry data points straight into the mapping: read it with
+// OpenIO() (SDL_IOFromConstMem, no copy) while the pack is open.
+class AssetPack
+{
+public:
+    AssetPack() = default;
+    ~AssetPack() { Close(); }
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return base_ != nullptr; }
+
+    // Entry data and size, or nullptr if the pack has no such name
+    const void* Find(const std::string& name, size_t& size) const;
+
+    // A read-only stream over the entry, or nullptr. Close it before the pack.
+    SDL_IOStream* OpenIO(const std::string& name) const;
+
+    Uint32 Count() const { return header_ ? header_->entryCount : 0; }
+    bool   Mapped() const { return mapped_; } // false: read into memory instead
+    const std::string& Path() const { return path_; }
+
+private:
+    const Uint8*      base_   = nullptr; // whole file, mapped or loaded
+    size_t            size_   = 0;
+    const PackHeader* header_ = nullptr;
+    const PackSlot*   slots_  = nullptr;
+    bool              mapped_ = false;   // else SDL_LoadFile'd
+    std::string       path_;
+};
@@ -0,0 +1,238 @@
+// src/atlas.cpp - Texture atlas: many small sprites packed into a few pages
+#include "atlas.h"
+
+#include <algorithm>
+#include <iostream>
+
+// Each sprite gets a 1 px border copied from its own edge pixels, so
+// linear filtering never samples a neighbouring sprite.
+static constexpr int kPad = 1;
+
+// ----------------------------------------------------------------------
+// SkylinePacker
+// ----------------------------------------------------------------------
+SkylinePacker::SkylinePacker(int width, int height)
+    : width_(width), height_(height)
+{
+    skyline_.push_back(Node{ 0, 0, width });
+}
+
+int SkylinePacker::Fit(size_t i, int w, int h) const
+{
+    if (skyline_[i].x + w > width_) return -1;
+
+    int y = skyline_[i].y;
+    int widthLeft = w;
+    for (size_t j = i; widthLeft > 0; ++j) {
+        y = std::max(y, skyline_[j].y);
+        if (y + h > height_) return -1;
+        widthLeft -= skyline_[j].w;
+    }
+    return y;
+}
+
+bool SkylinePacker::Insert(int w, int h, SDL_Point& out)
+{
+    int    bestTop = height_ + 1;
+    int    bestX   = 0;
+    size_t bestI   = skyline_.size();
+
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        int y = Fit(i, w, h);
+        if (y < 0) continue;
+        // Bottom-left: lowest resulting top edge, then leftmost
+        if (y + h < bestTop || (y + h == bestTop && skyline_[i].x < bestX)) {
+            bestTop = y + h;
+            bestX   = skyline_[i].x;
+            bestI   = i;
+        }
+    }
+    if (bestI == skyline_.size()) return false;
+
+    out.x = bestX;
+    out.y = bestTop - h;
+
+    // Raise the skyline under the new rect
+    skyline_.insert(skyline_.begin() + bestI, Node{ bestX, bestTop, w });
+    for (size_t i = bestI + 1; i < skyline_.size();) {
+        const Node& prev = skyline_[i - 1];
+        int shrink = prev.x + prev.w - skyline_[i].x;
+        if (shrink <= 0) break;
+
+        skyline_[i].x += shrink;
+        skyline_[i].w -= shrink;
+        if (skyline_[i].w > 0) break;
+        skyline_.erase(skyline_.begin() + i);
+    }
+
+    // Merge neighbouring segments at the same height
+    for (size_t i = 0; i + 1 < skyline_.size();) {
+        if (skyline_[i].y == skyline_[i + 1].y) {
+            skyline_[i].w += skyline_[i + 1].w;
+            skyline_.erase(skyline_.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// TextureAtlas
+// ----------------------------------------------------------------------
+void TextureAtlas::Add(const std::string& name, SDL_Surface* surf, const ImageMeta& meta)
+{
+    if (!surf) return;
+
+    Entry e;
+    e.name = name;
+    e.surf = surf;
+    e.meta = meta;
+    entries_.push_back(e);
+}
+
+bool TextureAtlas::Build(RenderBackend& backend, int pageSize)
+{
+    // Tallest first packs a skyline best
+    std::vector<size_t> order;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].surf) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return entries_[a].surf->h > entries_[b].surf->h;
+    });
+
+    // Pass 1: assign every sprite a page and a position
+    struct PagePlan
+    {
+        SkylinePacker packer;
+        int usedW = 0;
+        int usedH = 0;
+    };
+    std::vector<PagePlan> plans;
+    std::vector<int>       pageOf(entries_.size(), -1);
+    std::vector<SDL_Point> posOf(entries_.size(), SDL_Point{ 0, 0 });
+
+    for (size_t idx : order) {
+        const SDL_Surface* s = entries_[idx].surf;
+        int needW = s->w + 2 * kPad;
+        int needH = s->h + 2 * kPad;
+
+        SDL_Point pos{};
+        int page = -1;
+        for (size_t p = 0; p < plans.size() && page < 0; ++p) {
+            if (plans[p].packer.Insert(needW, needH, pos)) page = (int)p;
+        }
+        if (page < 0) {
+            // New page; oversized sprites get a page of their own size
+            plans.push_back(PagePlan{ SkylinePacker(std::max(pageSize, needW),
+                                                    std::max(pageSize, needH)) });
+            page = (int)plans.size() - 1;
+            plans.back().packer.Insert(needW, needH, pos);
+        }
+
+        pageOf[idx] = page;
+        posOf[idx]  = pos;
+        plans[page].usedW = std::max(plans[page].usedW, pos.x + needW);
+        plans[page].usedH = std::max(plans[page].usedH, pos.y + needH);
+    }
+
+    // One alpha convention per page. Cooked images may point into a
+    // read-only pack, so it's the straight ones that get converted.
+    bool premultiplied = false;
+    for (size_t idx : order) premultiplied |= entries_[idx].meta.premultiplied;
+    for (size_t idx : order) {
+        Entry& e = entries_[idx];
+        if (premultiplied && !e.meta.premultiplied) {
+            SDL_PremultiplySurfaceAlpha(e.surf, false);
+        }
+    }
+
+    // Pass 2: blit into page surfaces trimmed to what was used, upload
+    bool ok = true;
+    for (size_t p = 0; p < plans.size(); ++p) {
+        SDL_Surface* pageSurf = SDL_CreateSurface(plans[p].usedW, plans[p].usedH,
+                                                  (SDL_PixelFormat)kCookedFormat);
+        if (!pageSurf) {
+            std::cerr << "Atlas: SDL_CreateSurface failed: " << SDL_GetError() << "\n";
+            pages_.push_back(kNoTexture);
+            ok = false;
+            continue;
+        }
+        SDL_ClearSurface(pageSurf, 0.f, 0.f, 0.f, 0.f);
+
+        for (size_t idx : order) {
+            if (pageOf[idx] != (int)p) continue;
+            SDL_Surface* s = entries_[idx].surf;
+            SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE); // copy alpha as-is
+
+            // Edge extrusion: the sprite shifted by one pixel each way,
+            // diagonals included so the padding's corner texels are
+            // filled too, then the sprite itself on top.
+            const SDL_Point offsets[9] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 },
+                                           { -1, 0 },  { 1, 0 },  { 0, -1 }, { 0, 1 },
+                                           { 0, 0 } };
+            for (const SDL_Point& o : offsets) {
+                SDL_Rect dst{ posOf[idx].x + kPad + o.x, posOf[idx].y + kPad + o.y, s->w, s->h };
+                SDL_BlitSurface(s, nullptr, pageSurf, &dst);
+            }
+        }
+
+        TextureId tex = backend.CreateTexture(pageSurf);
+        if (tex == kNoTexture) {
+            std::cerr << "Atlas: cannot upload page " << p << "\n";
+            ok = false;
+        } else {
+            bytes_ += (Uint64)pageSurf->w * pageSurf->h * 4;
+        }
+
+        // Fill in the sprite handles for this page
+        for (size_t idx : order) {
+            if (pageOf[idx] != (int)p) continue;
+            Entry& e = entries_[idx];
+            float x = (float)(posOf[idx].x + kPad);
+            float y = (float)(posOf[idx].y + kPad);
+            float w = (float)e.surf->w;
+            float h = (float)e.surf->h;
+
+            e.sprite.page = tex;
+            e.sprite.src  = SDL_FRect{ x, y, w, h };
+            e.sprite.uv   = SDL_FRect{ x / pageSurf->w, y / pageSurf->h,
+                                       w / pageSurf->w, h / pageSurf->h };
+            e.sprite.trim  = e.meta.trim;
+            e.sprite.blend = premultiplied ? SDL_BLENDMODE_BLEND_PREMULTIPLIED
+                                           : SDL_BLENDMODE_BLEND;
+        }
+
+        pages_.push_back(tex);
+        SDL_DestroySurface(pageSurf);
+    }
+
+    for (Entry& e : entries_) {
+        if (e.surf) SDL_DestroySurface(e.surf);
+        e.surf = nullptr;
+    }
+
+    std::cout << "Atlas: packed " << order.size() << " sprites into "
+              << pages_.size() << " page(s).\n";
+    return ok;
+}
+
+const Sprite* TextureAtlas::Find(const std::string& name) const
+{
+    for (const Entry& e : entries_) {
+        if (e.name == name) return e.sprite.page ? &e.sprite : nullptr;
+    }
+    return nullptr;
+}
+
+void TextureAtlas::Destroy(RenderBackend& backend)
+{
+    for (TextureId tex : pages_) {
+        if (tex != kNoTexture) backend.DestroyTexture(tex);
+    }
+    pages_.clear();
+    bytes_ = 0;
+    for (Entry& e : entries_) SDL_DestroySurface(e.surf); // if never built
+    entries_.clear();
+}
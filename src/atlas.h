@@ -0,0 +1,81 @@
+// src/atlas.h - Texture atlas: many small sprites packed into a few pages
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+#include "cooked_texture.h"
+#include "render_backend.h"
+
+// Where a sprite lives inside an atlas page. Cheap to copy; the page
+// texture is owned by the TextureAtlas.
+struct Sprite
+{
+    TextureId page = kNoTexture;
+    SDL_FRect src{};              // pixel rect in the page
+    SDL_FRect uv{};               // same rect normalised to [0, 1] (for DrawCmd)
+    SDL_FRect trim{ 0.f, 0.f, 1.f, 1.f }; // where those pixels go in the full sprite
+    SDL_BlendMode blend = SDL_BLENDMODE_BLEND; // _PREMULTIPLIED for premultiplied pages
+};
+
+// Skyline bottom-left rectangle packer for a single page
+class SkylinePacker
+{
+public:
+    SkylinePacker(int width, int height);
+
+    // Reserve a w x h rect. Returns false if it doesn't fit on this page.
+    bool Insert(int w, int h, SDL_Point& out);
+
+private:
+    struct Node
+    {
+        int x, y, w; // a horizontal segment of the skyline at height y
+    };
+
+    // Lowest y at which a w-wide rect can sit starting at node i, or -1
+    int Fit(size_t i, int w, int h) const;
+
+    int               width_;
+    int               height_;
+    std::vector<Node> skyline_;
+};
+
+class TextureAtlas
+{
+public:
+    // Queue an image for packing. The atlas takes ownership of `surf`;
+    // a null surface is ignored, so Find() later returns nullptr for it.
+    void Add(const std::string& name, SDL_Surface* surf, const ImageMeta& meta = ImageMeta{});
+
+    // Pack everything queued into pages of at most pageSize x pageSize,
+    // upload the pages and free the source surfaces. Pages are in the
+    // cooked format; if any image is premultiplied (cooked), so are the
+    // pages, and straight-alpha images are premultiplied on the way in.
+    bool Build(RenderBackend& backend, int pageSize = 2048);
+
+    // Sprite by name, or nullptr if it was never added / failed to load.
+    const Sprite* Find(const std::string& name) const;
+
+    size_t PageCount() const { return pages_.size(); }
+
+    // Estimated VRAM of the uploaded pages: 4 bytes a pixel
+    Uint64 Bytes() const { return bytes_; }
+
+    // Release the page textures. Call before shutting the backend down.
+    void Destroy(RenderBackend& backend);
+
+private:
+    struct Entry
+    {
+        std::string  name;
+        SDL_Surface* surf = nullptr; // only until Build()
+        ImageMeta    meta;
+        Sprite       sprite;
+    };
+
+    std::vector<Entry>     entries_;
+    std::vector<TextureId> pages_;
+    Uint64                 bytes_ = 0;
+};
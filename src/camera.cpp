@@ -0,0 +1,26 @@
+// src/camera.cpp - Scrolling camera: which part of the level is on screen
+#include "camera.h"
+
+#include <cmath>
+
+#include "sim.h"
+
+// Left/top edge of a `size`-wide view centred on `centre`, kept inside
+// [lo, lo + range]
+static float ClampAxis(float centre, float size, float lo, float range)
+{
+    if (range <= size) return lo + (range - size) * 0.5f;
+
+    float edge = centre - size * 0.5f;
+    if (edge < lo) edge = lo;
+    if (edge > lo + range - size) edge = lo + range - size;
+    return edge;
+}
+
+void Camera::Follow(const SDL_FRect& target)
+{
+    view_.w = kViewW;
+    view_.h = kViewH;
+    view_.x = std::round(ClampAxis(target.x + target.w * 0.5f, kViewW, bounds_.x, bounds_.w));
+    view_.y = std::round(ClampAxis(target.y + target.h * 0.5f, kViewH, bounds_.y, bounds_.h));
+}
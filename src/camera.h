@@ -0,0 +1,30 @@
+// src/camera.h - Scrolling camera: which part of the level is on screen
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// A kViewW x kViewH window onto the level. Draw lists are built in view
+// coordinates, so the backends never see world positions.
+class Camera
+{
+public:
+    // The camera never shows anything outside `bounds`. A level smaller
+    // than the view on an axis is centred on that axis instead.
+    void SetBounds(const SDL_FRect& bounds) { bounds_ = bounds; }
+
+    // Centre on `target` (clamped to the bounds), snapped to whole pixels
+    // so tiles don't shimmer while scrolling.
+    void Follow(const SDL_FRect& target);
+
+    // World-space rectangle currently visible
+    const SDL_FRect& View() const { return view_; }
+
+    SDL_FRect WorldToScreen(const SDL_FRect& r) const
+    {
+        return SDL_FRect{ r.x - view_.x, r.y - view_.y, r.w, r.h };
+    }
+
+private:
+    SDL_FRect bounds_{};
+    SDL_FRect view_{};
+};
@@ -0,0 +1,38 @@
+// src/cooked_texture.cpp - Cooked texture blobs: pixels ready to upload as-is
+#include "cooked_texture.h"
+
+#include <iostream>
+
+SDL_Surface* CookedTextureSurface(const void* data, size_t size, ImageMeta& meta)
+{
+    if (!IsCookedTexture(data, size)) return nullptr;
+
+    CookedTextureHeader header;
+    SDL_memcpy(&header, data, sizeof(header));
+    const char* problem = nullptr;
+    if (header.version != kCookedVersion) {
+        problem = "unsupported version";
+    } else if (header.format != kCookedFormat || header.pitch < header.width * 4) {
+        problem = "unexpected pixel format";
+    } else if ((Uint64)header.pitch * header.height > size - sizeof(header)) {
+        problem = "truncated";
+    }
+    if (problem) {
+        std::cerr << "Cooked texture: " << problem << ".\n";
+        return nullptr;
+    }
+
+    // Header size keeps the rows 4-byte aligned
+    void* pixels = (Uint8*)data + sizeof(header);
+    SDL_Surface* surf = SDL_CreateSurfaceFrom((int)header.width, (int)header.height,
+                                              (SDL_PixelFormat)header.format, pixels,
+                                              (int)header.pitch);
+    if (!surf) {
+        std::cerr << "Cooked texture: SDL_CreateSurfaceFrom failed: " << SDL_GetError() << "\n";
+        return nullptr;
+    }
+
+    meta.premultiplied = (header.flags & kCookedPremultiplied) != 0;
+    meta.trim = SDL_FRect{ header.trim[0], header.trim[1], header.trim[2], header.trim[3] };
+    return surf;
+}
@@ -0,0 +1,47 @@
+// src/cooked_texture.h - Cooked texture blobs: pixels ready to upload as-is
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstring>
+
+// A cooked texture (written by tools/cook_assets.cpp, flip-man-cook) is a
+// header followed by the pixel rows:
+//   - in kCookedFormat, which SDL_Renderer's drivers take without
+//     conversion and SDL_GPU samples as B8G8R8A8,
+//   - with alpha premultiplied,
+//   - resized to the size they're drawn at in the view, and
+//   - optionally trimmed to their opaque pixels; `trim` says where the
+//     remaining pixels sit in the full image.
+struct CookedTextureHeader
+{
+    char   magic[4]; // kCookedMagic
+    Uint32 version;  // kCookedVersion
+    Uint32 format;   // SDL_PixelFormat, kCookedFormat
+    Uint32 width;
+    Uint32 height;
+    Uint32 pitch;    // bytes per row
+    Uint32 flags;    // kCooked* bits
+    float  trim[4];  // x, y, w, h of the pixels in the full image, normalised
+};
+
+constexpr char   kCookedMagic[4]      = { 'F', 'M', 'T', 'X' };
+constexpr Uint32 kCookedVersion       = 1;
+constexpr Uint32 kCookedFormat        = SDL_PIXELFORMAT_ARGB8888;
+constexpr Uint32 kCookedPremultiplied = 1u << 0;
+
+// What an image carries besides its pixels. Plain decoded files get the
+// defaults: straight alpha, untrimmed.
+struct ImageMeta
+{
+    bool      premultiplied = false;
+    SDL_FRect trim{ 0.f, 0.f, 1.f, 1.f }; // pixels' rect in the full image, normalised
+};
+
+inline bool IsCookedTexture(const void* data, size_t size)
+{
+    return size >= sizeof(CookedTextureHeader) && std::memcmp(data, kCookedMagic, 4) == 0;
+}
+
+// A surface over the blob's pixels - no copy, so `data` must outlive it -
+// or nullptr (with a message) if the blob is malformed.
+SDL_Surface* CookedTextureSurface(const void* data, size_t size, ImageMeta& meta);
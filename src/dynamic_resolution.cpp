@@ -0,0 +1,67 @@
+// src/dynamic_resolution.cpp - Internal render resolution driven by frame time
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static constexpr double kSmoothing    = 0.1;   // weight of the newest frame
+static constexpr double kHighWater    = 0.85;  // shrink above this share of the budget
+static constexpr double kLowWater     = 0.6;   // grow below it
+static constexpr double kShrinkTarget = 0.75;  // aim for this share when shrinking
+static constexpr double kMaxShrink    = 0.5;   // smallest factor in one step
+static constexpr double kMissedStep   = 0.95;  // largest factor after a missed deadline
+static constexpr float  kGrowStep     = 0.05f;
+static constexpr int    kShrinkCooldown = 15;  // frames
+static constexpr int    kGrowCooldown   = 30;
+
+ResolutionController::ResolutionController(Uint64 budgetNS, float minScale)
+    : budgetNS_(budgetNS), minScale_(std::clamp(minScale, 0.1f, 1.f)),
+      cooldown_(kGrowCooldown) // startup frames (uploads, first present) aren't representative
+{
+}
+
+float ResolutionController::Update(Uint64 workNS, bool missedDeadline)
+{
+    if (!Enabled()) return scale_;
+
+    smoothedNS_ = (smoothedNS_ == 0.0)
+        ? (double)workNS
+        : smoothedNS_ + kSmoothing * ((double)workNS - smoothedNS_);
+
+    if (cooldown_ > 0) {
+        --cooldown_;
+        return scale_;
+    }
+
+    const double budget = (double)budgetNS_;
+    float next = scale_;
+    if (missedDeadline || smoothedNS_ > budget * kHighWater) {
+        double ratio = std::sqrt(budget * kShrinkTarget / std::max(smoothedNS_, 1.0));
+        if (missedDeadline) ratio = std::min(ratio, kMissedStep);
+        next = scale_ * (float)std::max(ratio, kMaxShrink);
+        cooldown_ = kShrinkCooldown;
+    } else if (smoothedNS_ < budget * kLowWater) {
+        next = scale_ + kGrowStep;
+        cooldown_ = kGrowCooldown;
+    }
+
+    next = std::clamp(next, minScale_, 1.f);
+    if (next != scale_) {
+        scale_ = next;
+        ++changes_;
+        lowestScale_ = std::min(lowestScale_, scale_);
+        // The cost at the old scale says little about the new one
+        smoothedNS_ = 0.0;
+    }
+    return scale_;
+}
+
+void ResolutionController::Report() const
+{
+    if (!Enabled()) return;
+
+    std::cout << "Dynamic resolution: final scale " << scale_
+              << ", lowest " << lowestScale_
+              << ", " << changes_ << " changes\n";
+}
@@ -0,0 +1,41 @@
+// src/dynamic_resolution.h - Internal render resolution driven by frame time
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Picks the scale of the internal render resolution (1 = native) from
+// measured frame work. Pixel cost grows with the square of the scale, so
+// an over-budget frame shrinks it by sqrt(target / measured) at once (at
+// most halving it, against absurd spikes). A missed deadline whose work
+// time looks fine - the GPU is behind - says nothing about how far to
+// go, so it shrinks by at least 5%. Headroom grows the scale back in
+// small steps. A cooldown after every change keeps it from oscillating
+// while the smoothed time settles.
+class ResolutionController
+{
+public:
+    // budgetNS is the frame period; 0 (uncapped) disables the controller
+    ResolutionController(Uint64 budgetNS, float minScale = 0.5f);
+
+    // Feed one frame: the time spent building and rendering it, and
+    // whether the pacer saw it miss its deadline (the only sign of
+    // GPU-bound frames when present blocks on vsync). Returns the scale
+    // to render the next frame at.
+    float Update(Uint64 workNS, bool missedDeadline);
+
+    float Scale() const   { return scale_; }
+    bool  Enabled() const { return budgetNS_ > 0; }
+
+    // Print a one-line summary of the scale history to stdout.
+    void Report() const;
+
+private:
+    Uint64 budgetNS_;
+    float  minScale_;
+    float  scale_      = 1.f;
+    double smoothedNS_ = 0.0; // exponential moving average of workNS
+    int    cooldown_;         // frames until the scale may change again
+
+    float  lowestScale_ = 1.f;
+    Uint64 changes_     = 0;
+};
@@ -0,0 +1,115 @@
+// src/frame_capture.cpp - Captured frames written to disk on a background thread
+#include "frame_capture.h"
+
+#include <iostream>
+
+FrameCapture::FrameCapture(const std::string& prefix)
+    : prefix_(prefix)
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+    Stop();
+    if (wake_)  SDL_DestroyCondition(wake_);
+    if (mutex_) SDL_DestroyMutex(mutex_);
+}
+
+void FrameCapture::Stop()
+{
+    if (!thread_) return;
+
+    SDL_LockMutex(mutex_);
+    quit_ = true;
+    SDL_SignalCondition(wake_);
+    SDL_UnlockMutex(mutex_);
+    SDL_WaitThread(thread_, nullptr);
+    thread_ = nullptr;
+}
+
+bool FrameCapture::Start()
+{
+    if (thread_) return true;
+
+    // Kept across Stop() / failed starts; the destructor frees them
+    if (!mutex_) mutex_ = SDL_CreateMutex();
+    if (!wake_)  wake_  = SDL_CreateCondition();
+    quit_ = false; // no writer running, so no lock needed
+    if (mutex_ && wake_) {
+        thread_ = SDL_CreateThread(WriterMain, "frame-writer", this);
+    }
+    if (!thread_) {
+        std::cerr << "Frame capture: cannot start writer thread: " << SDL_GetError()
+                  << " - capture disabled.\n";
+        return false;
+    }
+    return true;
+}
+
+void FrameCapture::Submit(SDL_Surface* frame)
+{
+    if (!frame) return;
+    if (!thread_) {
+        SDL_DestroySurface(frame);
+        return;
+    }
+
+    SDL_LockMutex(mutex_);
+    const Uint32 number = submitted_++;
+    if (queue_.size() >= kMaxQueued) {
+        ++dropped_;
+        SDL_UnlockMutex(mutex_);
+        SDL_DestroySurface(frame);
+        return;
+    }
+    queue_.push_back(Pending{ number, frame });
+    SDL_SignalCondition(wake_);
+    SDL_UnlockMutex(mutex_);
+}
+
+int FrameCapture::WriterMain(void* self)
+{
+    FrameCapture& cap = *(FrameCapture*)self;
+
+    SDL_LockMutex(cap.mutex_);
+    for (;;) {
+        while (!cap.quit_ && cap.queue_.empty()) {
+            SDL_WaitCondition(cap.wake_, cap.mutex_);
+        }
+        // Drain the queue before quitting, so the last frames aren't lost
+        if (cap.queue_.empty()) break;
+
+        Pending next = cap.queue_.front();
+        cap.queue_.pop_front();
+
+        SDL_UnlockMutex(cap.mutex_);
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "%06u.bmp", next.number);
+        const std::string path = cap.prefix_ + name;
+        const bool ok = SDL_SaveBMP(next.frame, path.c_str());
+        if (!ok) {
+            std::cerr << "Frame capture: SDL_SaveBMP failed for '" << path << "': "
+                      << SDL_GetError() << "\n";
+        }
+        SDL_DestroySurface(next.frame);
+        SDL_LockMutex(cap.mutex_);
+
+        if (ok) ++cap.written_;
+        else    ++cap.failed_;
+    }
+    SDL_UnlockMutex(cap.mutex_);
+    return 0;
+}
+
+void FrameCapture::Report() const
+{
+    if (!mutex_) return;
+
+    SDL_LockMutex(mutex_);
+    if (submitted_ > 0) {
+        std::cout << "Frame capture: " << submitted_ << " frames captured, "
+                  << written_ << " written to '" << prefix_ << "*.bmp', "
+                  << dropped_ << " dropped (writer behind), " << failed_ << " failed\n";
+    }
+    SDL_UnlockMutex(mutex_);
+}
@@ -0,0 +1,59 @@
+// src/frame_capture.h - Captured frames written to disk on a background thread
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <string>
+
+// Receives finished frames from a render backend and saves each one as
+// `<prefix>NNNNNN.bmp` on a writer thread. Backends read pixels back a
+// few frames late so nothing waits on the GPU; this class makes sure the
+// render thread never waits on the disk either: when the writer falls
+// behind by kMaxQueued frames, new frames are dropped (and counted).
+class FrameCapture
+{
+public:
+    explicit FrameCapture(const std::string& prefix);
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Start the writer thread. Without it, Submit() drops every frame.
+    bool Start();
+
+    // Hand over a captured frame; the surface is freed by the writer.
+    void Submit(SDL_Surface* frame);
+
+    // Write out whatever is still queued and stop the writer thread.
+    // Later frames are dropped.
+    void Stop();
+
+    // Print a one-line summary (frames written, dropped) to stdout.
+    void Report() const;
+
+private:
+    static constexpr size_t kMaxQueued = 16; // ~30 MB at 800x600
+
+    struct Pending
+    {
+        Uint32       number; // file number; gaps mark dropped frames
+        SDL_Surface* frame;
+    };
+
+    static int WriterMain(void* self);
+
+    std::string prefix_;
+
+    SDL_Thread*    thread_ = nullptr;
+    SDL_Mutex*     mutex_  = nullptr;
+    SDL_Condition* wake_   = nullptr;
+    bool           quit_   = false;
+    std::deque<Pending> queue_; // under mutex_
+
+    // Stats, under mutex_
+    Uint32 submitted_ = 0;
+    Uint32 written_   = 0;
+    Uint32 dropped_   = 0;
+    Uint32 failed_    = 0;
+};
@@ -0,0 +1,114 @@
+// src/frame_pacer.cpp - Frame pacing: vsync, precise-sleep frame cap, or uncapped
+#include "frame_pacer.h"
+
+#include <cstring>
+#include <iostream>
+
+bool ParsePacingMode(const char* name, PacingMode& out)
+{
+    if (std::strcmp(name, "vsync") == 0)    { out = PacingMode::VSync;    return true; }
+    if (std::strcmp(name, "capped") == 0)   { out = PacingMode::Capped;   return true; }
+    if (std::strcmp(name, "uncapped") == 0) { out = PacingMode::Uncapped; return true; }
+    return false;
+}
+
+const char* PacingModeName(PacingMode mode)
+{
+    switch (mode) {
+    case PacingMode::VSync:    return "vsync";
+    case PacingMode::Capped:   return "capped";
+    case PacingMode::Uncapped: return "uncapped";
+    }
+    return "?";
+}
+
+FramePacer::FramePacer(SDL_Window* window, bool vsyncActive, PacingMode mode, int targetFps)
+    : mode_(mode)
+{
+    Setup(window, vsyncActive, targetFps);
+}
+
+void FramePacer::Setup(SDL_Window* window, bool vsyncActive, int targetFps)
+{
+    if (targetFps <= 0) targetFps = 60;
+
+    if (mode_ == PacingMode::VSync) {
+        if (!vsyncActive) {
+            std::cerr << "VSync unavailable - falling back to a capped frame rate.\n";
+            mode_ = PacingMode::Capped;
+        } else {
+            // Use the display refresh as the deadline, if it reports one
+            SDL_DisplayID display = SDL_GetDisplayForWindow(window);
+            const SDL_DisplayMode* dm = SDL_GetCurrentDisplayMode(display);
+            if (dm && dm->refresh_rate > 0.f) {
+                periodNS_ = (Uint64)((double)SDL_NS_PER_SECOND / dm->refresh_rate);
+            }
+        }
+    }
+
+    if (mode_ != PacingMode::Uncapped && periodNS_ == 0) {
+        periodNS_ = SDL_NS_PER_SECOND / (Uint64)targetFps;
+    }
+
+    lastEndNS_  = SDL_GetTicksNS();
+    deadlineNS_ = lastEndNS_ + periodNS_;
+}
+
+void FramePacer::EndFrame()
+{
+    Uint64 now = SDL_GetTicksNS();
+
+    if (mode_ == PacingMode::Capped) {
+        if (now >= deadlineNS_) {
+            // Too late: don't try to catch up, just restart the schedule
+            ++stats_.missedDeadlines;
+            deadlineNS_ = now + periodNS_;
+        } else {
+            Uint64 target = deadlineNS_;
+            SDL_DelayPrecise(target - now);
+            now = SDL_GetTicksNS();
+
+            Uint64 overshoot = (now > target) ? now - target : 0;
+            ++stats_.sleeps;
+            stats_.overshootSumNS += overshoot;
+            if (overshoot > stats_.overshootMaxNS) stats_.overshootMaxNS = overshoot;
+
+            deadlineNS_ += periodNS_;
+        }
+    } else if (mode_ == PacingMode::VSync) {
+        // Present already blocked on the refresh; a frame that took more
+        // than 1.5 periods skipped at least one vblank.
+        if (now - lastEndNS_ > periodNS_ + periodNS_ / 2) {
+            ++stats_.missedDeadlines;
+        }
+    }
+
+    Uint64 frameNS = now - lastEndNS_;
+    lastEndNS_ = now;
+
+    ++stats_.frames;
+    stats_.frameSumNS += frameNS;
+    if (frameNS > stats_.frameMaxNS) stats_.frameMaxNS = frameNS;
+}
+
+void FramePacer::Report() const
+{
+    const double nsToMs = 1.0 / 1000000.0;
+
+    std::cout << "Frame pacing (" << PacingModeName(mode_) << "): "
+              << stats_.frames << " frames";
+    if (stats_.frames > 0) {
+        std::cout << ", avg " << (double)stats_.frameSumNS / stats_.frames * nsToMs
+                  << " ms, max " << stats_.frameMaxNS * nsToMs << " ms";
+    }
+    std::cout << "\n";
+
+    if (mode_ != PacingMode::Uncapped) {
+        std::cout << "  missed deadlines: " << stats_.missedDeadlines << "\n";
+    }
+    if (stats_.sleeps > 0) {
+        std::cout << "  sleep overshoot: avg "
+                  << (double)stats_.overshootSumNS / stats_.sleeps * nsToMs
+                  << " ms, max " << stats_.overshootMaxNS * nsToMs << " ms\n";
+    }
+}
@@ -0,0 +1,59 @@
+// src/frame_pacer.h - Frame pacing: vsync, precise-sleep frame cap, or uncapped
+#pragma once
+
+#include <SDL3/SDL.h>
+
+enum class PacingMode
+{
+    VSync,    // block in present on the display refresh
+    Capped,   // sleep with SDL_DelayPrecise to a fixed frame rate
+    Uncapped, // run as fast as possible (benchmarking)
+};
+
+// Parse "vsync" / "capped" / "uncapped". Returns false on unknown names.
+bool ParsePacingMode(const char* name, PacingMode& out);
+const char* PacingModeName(PacingMode mode);
+
+struct PacingStats
+{
+    Uint64 frames          = 0;
+    Uint64 missedDeadlines = 0; // frames that finished after their deadline
+
+    Uint64 sleeps          = 0;
+    Uint64 overshootSumNS  = 0; // how late SDL_DelayPrecise woke us up
+    Uint64 overshootMaxNS  = 0;
+
+    Uint64 frameSumNS      = 0;
+    Uint64 frameMaxNS      = 0;
+};
+
+class FramePacer
+{
+public:
+    // The render backend sets up its own swap interval; `vsyncActive`
+    // says whether VSync mode actually got vsync. targetFps is used by
+    // Capped mode. It also sets the deadline used to count missed frames
+    // in VSync mode when the display reports no rate.
+    FramePacer(SDL_Window* window, bool vsyncActive, PacingMode mode, int targetFps);
+
+    // Call once after presenting. Sleeps in Capped mode and
+    // records frame timing for every mode.
+    void EndFrame();
+
+    PacingMode         Mode() const     { return mode_; }
+    Uint64             PeriodNS() const { return periodNS_; } // 0 when uncapped
+    const PacingStats& Stats() const    { return stats_; }
+
+    // Print a one-block summary of the collected stats to stdout.
+    void Report() const;
+
+private:
+    void Setup(SDL_Window* window, bool vsyncActive, int targetFps);
+
+    PacingMode  mode_;
+    PacingStats stats_;
+
+    Uint64 periodNS_   = 0; // target frame period
+    Uint64 deadlineNS_ = 0; // when the current frame should end
+    Uint64 lastEndNS_  = 0; // when the previous frame ended
+};
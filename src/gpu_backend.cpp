@@ -0,0 +1,60 @@
+// src/gpu_backend.cpp - RenderBackend on top of the SDL_GPU sprite renderer
+#include "gpu_backend.h"
+
+void GpuBackend::Shutdown()
+{
+    for (SDL_GPUTexture* tex : textures_) gpu_.ReleaseTexture(tex);
+    textures_.clear();
+    gpu_.Shutdown();
+}
+
+TextureId GpuBackend::CreateTexture(SDL_Surface* surf)
+{
+    if (!surf) return kNoTexture;
+
+    SDL_GPUTexture* tex = gpu_.CreateTexture(surf);
+    if (!tex) return kNoTexture;
+    textures_.push_back(tex);
+    return (TextureId)textures_.size();
+}
+
+void GpuBackend::DestroyTexture(TextureId tex)
+{
+    if (tex == kNoTexture || tex > textures_.size()) return;
+
+    gpu_.ReleaseTexture(textures_[tex - 1]);
+    textures_[tex - 1] = nullptr;
+}
+
+void GpuBackend::Queue(const DrawList& list)
+{
+    for (const DrawCmd& cmd : list.cmds) {
+        SDL_GPUTexture* tex = (cmd.texture != kNoTexture && cmd.texture <= textures_.size())
+            ? textures_[cmd.texture - 1] : nullptr;
+        gpu_.DrawSprite(tex, cmd.dst, cmd.uv, cmd.angle, cmd.color, cmd.wrap,
+                        cmd.blend == SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    }
+}
+
+void GpuBackend::DrawStatic(const DrawList& list, Uint64)
+{
+    gpu_.SetClearColor(list.clearColor);
+    Queue(list);
+}
+
+void GpuBackend::DrawDynamic(const DrawList& list)
+{
+    Queue(list);
+}
+
+void GpuBackend::Present()
+{
+    gpu_.EndFrame();
+
+    frameStats_.drawCalls      = gpu_.DrawsLastFrame();
+    frameStats_.vertices       = gpu_.SpritesLastFrame() * 6;
+    frameStats_.textureBinds   = gpu_.BindsLastFrame();
+    frameStats_.targetSwitches = gpu_.TargetSwitchesLastFrame();
+    frameStats_.bytesUploaded  = gpu_.UploadedLastFrame();
+    FinishFrameStats();
+}
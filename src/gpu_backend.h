@@ -0,0 +1,38 @@
+// src/gpu_backend.h - RenderBackend on top of the SDL_GPU sprite renderer
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+#include "gpu_renderer.h"
+#include "render_backend.h"
+
+// Draw commands map one-to-one onto instanced sprites, so there is no
+// geometry to build; the static list is simply re-queued every frame.
+// The sprite pipeline always alpha-blends, so DrawCmd::blend only
+// affects batching here (opaque content looks the same either way).
+class GpuBackend : public RenderBackend
+{
+public:
+    RenderBackendKind Kind() const override { return RenderBackendKind::Gpu; }
+
+    bool Init(SDL_Window* window, bool vsync) override { return gpu_.Init(window, vsync); }
+    void Shutdown() override;
+    bool VSyncActive() const override { return gpu_.VSyncEnabled(); }
+
+    TextureId CreateTexture(SDL_Surface* surf) override;
+    void      DestroyTexture(TextureId tex) override;
+
+    void DrawStatic(const DrawList& list, Uint64 version) override;
+    void DrawDynamic(const DrawList& list) override;
+    void Present() override;
+
+    void SetResolutionScale(float scale) override { gpu_.SetResolutionScale(scale); }
+    void CaptureFrame(FrameCapture& sink) override { gpu_.CaptureNextFrame(sink); }
+
+private:
+    void Queue(const DrawList& list);
+
+    GpuSpriteRenderer            gpu_;
+    std::vector<SDL_GPUTexture*> textures_; // TextureId - 1 -> texture
+};
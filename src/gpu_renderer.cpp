@@ -0,0 +1,560 @@
+// src/gpu_renderer.cpp - SDL_GPU sprite renderer (instanced quads)
+#include "gpu_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "frame_capture.h"
+#include "sim.h"
+
+// Load a compiled SPIR-V shader from <exe dir>/shaders/
+static SDL_GPUShader* LoadShader(SDL_GPUDevice* device, const char* file,
+                                 SDL_GPUShaderStage stage, Uint32 numSamplers,
+                                 Uint32 numStorageBuffers, Uint32 numUniformBuffers)
+{
+    const char* base = SDL_GetBasePath();
+    std::string path = std::string(base ? base : "") + "shaders/" + file;
+
+    size_t size = 0;
+    void* code = SDL_LoadFile(path.c_str(), &size);
+    if (!code) {
+        std::cerr << "GPU: cannot load shader '" << path << "': " << SDL_GetError() << "\n";
+        return nullptr;
+    }
+
+    SDL_GPUShaderCreateInfo info{};
+    info.code_size           = size;
+    info.code                = (const Uint8*)code;
+    info.entrypoint          = "main";
+    info.format              = SDL_GPU_SHADERFORMAT_SPIRV;
+    info.stage               = stage;
+    info.num_samplers        = numSamplers;
+    info.num_storage_buffers = numStorageBuffers;
+    info.num_uniform_buffers = numUniformBuffers;
+
+    SDL_GPUShader* shader = SDL_CreateGPUShader(device, &info);
+    if (!shader) {
+        std::cerr << "GPU: SDL_CreateGPUShader failed for '" << file << "': "
+                  << SDL_GetError() << "\n";
+    }
+    SDL_free(code);
+    return shader;
+}
+
+bool GpuSpriteRenderer::Init(SDL_Window* window, bool vsync)
+{
+    device_ = SDL_CreateGPUDevice(SDL_GPU_SHADERFORMAT_SPIRV, false, nullptr);
+    if (!device_) {
+        std::cerr << "GPU: SDL_CreateGPUDevice failed: " << SDL_GetError() << "\n";
+        return false;
+    }
+    if (!SDL_ClaimWindowForGPUDevice(device_, window)) {
+        std::cerr << "GPU: SDL_ClaimWindowForGPUDevice failed: " << SDL_GetError() << "\n";
+        SDL_DestroyGPUDevice(device_);
+        device_ = nullptr;
+        return false;
+    }
+    window_ = window;
+
+    // Uncapped prefers IMMEDIATE, then MAILBOX; VSYNC is always available
+    SDL_GPUPresentMode mode = SDL_GPU_PRESENTMODE_VSYNC;
+    if (!vsync) {
+        if (SDL_WindowSupportsGPUPresentMode(device_, window_, SDL_GPU_PRESENTMODE_IMMEDIATE)) {
+            mode = SDL_GPU_PRESENTMODE_IMMEDIATE;
+        } else if (SDL_WindowSupportsGPUPresentMode(device_, window_, SDL_GPU_PRESENTMODE_MAILBOX)) {
+            mode = SDL_GPU_PRESENTMODE_MAILBOX;
+        }
+    }
+    SDL_SetGPUSwapchainParameters(device_, window_, SDL_GPU_SWAPCHAINCOMPOSITION_SDR, mode);
+    vsync_ = (mode == SDL_GPU_PRESENTMODE_VSYNC);
+
+    SDL_GPUSamplerCreateInfo samplerInfo{};
+    samplerInfo.min_filter     = SDL_GPU_FILTER_LINEAR;
+    samplerInfo.mag_filter     = SDL_GPU_FILTER_LINEAR;
+    samplerInfo.mipmap_mode    = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST;
+    samplerInfo.address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+    samplerInfo.address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+    samplerInfo.address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+    sampler_ = SDL_CreateGPUSampler(device_, &samplerInfo);
+
+    // Same filtering, repeating, for tiled (wrap) sprites
+    samplerInfo.address_mode_u = SDL_GPU_SAMPLERADDRESSMODE_REPEAT;
+    samplerInfo.address_mode_v = SDL_GPU_SAMPLERADDRESSMODE_REPEAT;
+    samplerInfo.address_mode_w = SDL_GPU_SAMPLERADDRESSMODE_REPEAT;
+    wrapSampler_ = SDL_CreateGPUSampler(device_, &samplerInfo);
+
+    SDL_Surface* whiteSurf = SDL_CreateSurface(1, 1, SDL_PIXELFORMAT_RGBA32);
+    if (whiteSurf) {
+        SDL_ClearSurface(whiteSurf, 1.f, 1.f, 1.f, 1.f);
+        white_ = CreateTexture(whiteSurf);
+        SDL_DestroySurface(whiteSurf);
+    }
+
+    if (!sampler_ || !wrapSampler_ || !white_ || !CreatePipelines()) {
+        Shutdown();
+        return false;
+    }
+
+    std::cout << "GPU: using SDL_GPU driver '" << SDL_GetGPUDeviceDriver(device_) << "'\n";
+    return true;
+}
+
+bool GpuSpriteRenderer::CreatePipelines()
+{
+    SDL_GPUShader* vert = LoadShader(device_, "sprite.vert.spv", SDL_GPU_SHADERSTAGE_VERTEX, 0, 1, 1);
+    SDL_GPUShader* frag = LoadShader(device_, "sprite.frag.spv", SDL_GPU_SHADERSTAGE_FRAGMENT, 1, 0, 0);
+    if (!vert || !frag) {
+        if (vert) SDL_ReleaseGPUShader(device_, vert);
+        if (frag) SDL_ReleaseGPUShader(device_, frag);
+        return false;
+    }
+
+    // Straight alpha, same as SDL_BLENDMODE_BLEND
+    SDL_GPUColorTargetDescription target{};
+    target.format = SDL_GetGPUSwapchainTextureFormat(device_, window_);
+    target.blend_state.enable_blend          = true;
+    target.blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+    target.blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    target.blend_state.color_blend_op        = SDL_GPU_BLENDOP_ADD;
+    target.blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+    target.blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    target.blend_state.alpha_blend_op        = SDL_GPU_BLENDOP_ADD;
+
+    // No vertex buffers: corners come from gl_VertexIndex, sprites from
+    // the storage buffer via gl_InstanceIndex.
+    SDL_GPUGraphicsPipelineCreateInfo info{};
+    info.vertex_shader                    = vert;
+    info.fragment_shader                  = frag;
+    info.primitive_type                   = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+    info.rasterizer_state.fill_mode       = SDL_GPU_FILLMODE_FILL;
+    info.rasterizer_state.cull_mode       = SDL_GPU_CULLMODE_NONE;
+    info.target_info.color_target_descriptions = &target;
+    info.target_info.num_color_targets         = 1;
+
+    pipeline_ = SDL_CreateGPUGraphicsPipeline(device_, &info);
+
+    // Premultiplied alpha, same as SDL_BLENDMODE_BLEND_PREMULTIPLIED
+    target.blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+    premulPipeline_ = SDL_CreateGPUGraphicsPipeline(device_, &info);
+
+    if (!pipeline_ || !premulPipeline_) {
+        std::cerr << "GPU: SDL_CreateGPUGraphicsPipeline failed: " << SDL_GetError() << "\n";
+    }
+
+    SDL_ReleaseGPUShader(device_, vert);
+    SDL_ReleaseGPUShader(device_, frag);
+    return pipeline_ && premulPipeline_;
+}
+
+void GpuSpriteRenderer::Shutdown()
+{
+    if (!device_) return;
+
+    SDL_WaitForGPUIdle(device_);
+    for (SDL_GPUFence*& fence : fences_) {
+        if (fence) SDL_ReleaseGPUFence(device_, fence);
+        fence = nullptr;
+    }
+
+    // Everything has finished: hand over captures still in the ring, oldest first
+    for (Uint32 i = 0; i < kFramesInFlight; ++i) {
+        Readback& rb = readbacks_[(frameSlot_ + i) % kFramesInFlight];
+        if (rb.pending) DeliverCapture((frameSlot_ + i) % kFramesInFlight);
+        if (rb.buffer) SDL_ReleaseGPUTransferBuffer(device_, rb.buffer);
+        rb = Readback{};
+    }
+
+    if (storage_)  SDL_ReleaseGPUBuffer(device_, storage_);
+    if (transfer_) SDL_ReleaseGPUTransferBuffer(device_, transfer_);
+    if (white_)    SDL_ReleaseGPUTexture(device_, white_);
+    if (scene_)    SDL_ReleaseGPUTexture(device_, scene_);
+    if (sampler_)  SDL_ReleaseGPUSampler(device_, sampler_);
+    if (wrapSampler_) SDL_ReleaseGPUSampler(device_, wrapSampler_);
+    if (pipeline_) SDL_ReleaseGPUGraphicsPipeline(device_, pipeline_);
+    if (premulPipeline_) SDL_ReleaseGPUGraphicsPipeline(device_, premulPipeline_);
+    storage_  = nullptr;
+    transfer_ = nullptr;
+    white_    = nullptr;
+    scene_    = nullptr;
+    sampler_  = nullptr;
+    wrapSampler_ = nullptr;
+    pipeline_ = nullptr;
+    premulPipeline_ = nullptr;
+    capacity_ = 0;
+
+    if (window_) SDL_ReleaseWindowFromGPUDevice(device_, window_);
+    SDL_DestroyGPUDevice(device_);
+    device_ = nullptr;
+    window_ = nullptr;
+}
+
+SDL_GPUTexture* GpuSpriteRenderer::CreateTexture(SDL_Surface* surf)
+{
+    if (!device_ || !surf) return nullptr;
+
+    // Byte orders the GPU samples directly need no conversion pass
+    SDL_GPUTextureFormat format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+    SDL_Surface* rgba = surf;
+    if (surf->format == SDL_PIXELFORMAT_BGRA32) {
+        format = SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
+    } else if (surf->format != SDL_PIXELFORMAT_RGBA32) {
+        rgba = SDL_ConvertSurface(surf, SDL_PIXELFORMAT_RGBA32);
+        if (!rgba) {
+            std::cerr << "GPU: SDL_ConvertSurface failed: " << SDL_GetError() << "\n";
+            return nullptr;
+        }
+    }
+
+    SDL_GPUTextureCreateInfo texInfo{};
+    texInfo.type                 = SDL_GPU_TEXTURETYPE_2D;
+    texInfo.format               = format;
+    texInfo.usage                = SDL_GPU_TEXTUREUSAGE_SAMPLER;
+    texInfo.width                = (Uint32)rgba->w;
+    texInfo.height               = (Uint32)rgba->h;
+    texInfo.layer_count_or_depth = 1;
+    texInfo.num_levels           = 1;
+    SDL_GPUTexture* tex = SDL_CreateGPUTexture(device_, &texInfo);
+
+    const Uint32 rowBytes = (Uint32)rgba->w * 4;
+    SDL_GPUTransferBufferCreateInfo tbInfo{};
+    tbInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    tbInfo.size  = rowBytes * (Uint32)rgba->h;
+    SDL_GPUTransferBuffer* tb = tex ? SDL_CreateGPUTransferBuffer(device_, &tbInfo) : nullptr;
+
+    Uint8* dst = tb ? (Uint8*)SDL_MapGPUTransferBuffer(device_, tb, false) : nullptr;
+    if (!dst) {
+        std::cerr << "GPU: texture upload setup failed: " << SDL_GetError() << "\n";
+        if (tb)  SDL_ReleaseGPUTransferBuffer(device_, tb);
+        if (tex) SDL_ReleaseGPUTexture(device_, tex);
+        if (rgba != surf) SDL_DestroySurface(rgba);
+        return nullptr;
+    }
+
+    for (int y = 0; y < rgba->h; ++y) {
+        std::memcpy(dst + (size_t)y * rowBytes,
+                    (const Uint8*)rgba->pixels + (size_t)y * rgba->pitch, rowBytes);
+    }
+    SDL_UnmapGPUTransferBuffer(device_, tb);
+
+    SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(device_);
+    SDL_GPUCopyPass* copy = SDL_BeginGPUCopyPass(cmd);
+
+    SDL_GPUTextureTransferInfo src{};
+    src.transfer_buffer = tb;
+    SDL_GPUTextureRegion region{};
+    region.texture = tex;
+    region.w = (Uint32)rgba->w;
+    region.h = (Uint32)rgba->h;
+    region.d = 1;
+    SDL_UploadToGPUTexture(copy, &src, &region, false);
+
+    SDL_EndGPUCopyPass(copy);
+    SDL_SubmitGPUCommandBuffer(cmd);
+
+    SDL_ReleaseGPUTransferBuffer(device_, tb); // freed once the upload is done
+    uploadedPending_ += tbInfo.size;
+    if (rgba != surf) SDL_DestroySurface(rgba);
+    return tex;
+}
+
+void GpuSpriteRenderer::ReleaseTexture(SDL_GPUTexture* tex)
+{
+    if (device_ && tex) SDL_ReleaseGPUTexture(device_, tex);
+}
+
+void GpuSpriteRenderer::DrawSprite(SDL_GPUTexture* tex, const SDL_FRect& dst,
+                                   const SDL_FRect& uv, float angleDeg, SDL_FColor color,
+                                   bool wrap, bool premultiplied)
+{
+    if (!tex) tex = white_;
+
+    const float rad = angleDeg * (SDL_PI_F / 180.f);
+
+    GpuSpriteInstance inst;
+    inst.dst[0] = dst.x;             inst.dst[1] = dst.y;
+    inst.dst[2] = dst.w;             inst.dst[3] = dst.h;
+    inst.uv[0]  = uv.x;              inst.uv[1]  = uv.y;
+    inst.uv[2]  = uv.x + uv.w;       inst.uv[3]  = uv.y + uv.h;
+    inst.rot[0] = std::cos(rad);     inst.rot[1] = std::sin(rad);
+    inst.rot[2] = 0.f;               inst.rot[3] = 0.f;
+    inst.color[0] = color.r;         inst.color[1] = color.g;
+    inst.color[2] = color.b;         inst.color[3] = color.a;
+
+    if (batches_.empty() || batches_.back().texture != tex || batches_.back().wrap != wrap ||
+        batches_.back().premultiplied != premultiplied) {
+        batches_.push_back(Batch{ tex, wrap, premultiplied, (Uint32)instances_.size(), 0 });
+    }
+    ++batches_.back().count;
+    instances_.push_back(inst);
+}
+
+bool GpuSpriteRenderer::EnsureCapacity(Uint32 sprites)
+{
+    if (sprites <= capacity_) return true;
+
+    // Growing replaces the ring, so nothing in flight may still read it
+    SDL_WaitForGPUIdle(device_);
+    for (SDL_GPUFence*& fence : fences_) {
+        if (fence) SDL_ReleaseGPUFence(device_, fence);
+        fence = nullptr;
+    }
+    if (storage_)  SDL_ReleaseGPUBuffer(device_, storage_);
+    if (transfer_) SDL_ReleaseGPUTransferBuffer(device_, transfer_);
+    storage_  = nullptr;
+    transfer_ = nullptr;
+    capacity_ = 0;
+
+    Uint32 capacity = 1024;
+    while (capacity < sprites) capacity *= 2;
+    const Uint32 bytes = capacity * (Uint32)sizeof(GpuSpriteInstance);
+
+    SDL_GPUBufferCreateInfo bufInfo{};
+    bufInfo.usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+    bufInfo.size  = bytes;
+    storage_ = SDL_CreateGPUBuffer(device_, &bufInfo);
+
+    SDL_GPUTransferBufferCreateInfo tbInfo{};
+    tbInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    tbInfo.size  = bytes * kFramesInFlight;
+    transfer_ = SDL_CreateGPUTransferBuffer(device_, &tbInfo);
+
+    if (!storage_ || !transfer_) {
+        std::cerr << "GPU: cannot allocate room for " << capacity << " sprites: "
+                  << SDL_GetError() << "\n";
+        return false;
+    }
+    capacity_ = capacity;
+    return true;
+}
+
+bool GpuSpriteRenderer::EnsureScene(Uint32 width, Uint32 height)
+{
+    if (scene_ && sceneW_ == width && sceneH_ == height) return true;
+
+    // Released textures stay alive until frames in flight are done with them
+    if (scene_) SDL_ReleaseGPUTexture(device_, scene_);
+
+    SDL_GPUTextureCreateInfo texInfo{};
+    texInfo.type                 = SDL_GPU_TEXTURETYPE_2D;
+    texInfo.format               = SDL_GetGPUSwapchainTextureFormat(device_, window_);
+    texInfo.usage                = SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER;
+    texInfo.width                = width;
+    texInfo.height               = height;
+    texInfo.layer_count_or_depth = 1;
+    texInfo.num_levels           = 1;
+    scene_ = SDL_CreateGPUTexture(device_, &texInfo);
+    if (!scene_) {
+        std::cerr << "GPU: cannot create " << width << "x" << height
+                  << " scene target: " << SDL_GetError() << "\n";
+        sceneW_ = sceneH_ = 0;
+        return false;
+    }
+    sceneW_ = width;
+    sceneH_ = height;
+    return true;
+}
+
+bool GpuSpriteRenderer::EnsureReadback(Uint32 slot, Uint32 bytes)
+{
+    Readback& rb = readbacks_[slot];
+    if (rb.buffer && rb.size >= bytes) return true;
+
+    if (rb.buffer) SDL_ReleaseGPUTransferBuffer(device_, rb.buffer);
+    SDL_GPUTransferBufferCreateInfo info{};
+    info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    info.size  = bytes;
+    rb.buffer = SDL_CreateGPUTransferBuffer(device_, &info);
+    rb.size   = rb.buffer ? bytes : 0;
+    if (!rb.buffer) {
+        std::cerr << "GPU: cannot create capture readback buffer: " << SDL_GetError() << "\n";
+        return false;
+    }
+    return true;
+}
+
+void GpuSpriteRenderer::CaptureNextFrame(FrameCapture& sink)
+{
+    captureSink_      = &sink;
+    captureThisFrame_ = true;
+}
+
+void GpuSpriteRenderer::DeliverCapture(Uint32 slot)
+{
+    Readback& rb = readbacks_[slot];
+    rb.pending = false;
+
+    // The scene target has the swapchain format; only the common 8-bit
+    // ones map onto an SDL pixel format
+    SDL_PixelFormat format = SDL_PIXELFORMAT_UNKNOWN;
+    switch (SDL_GetGPUSwapchainTextureFormat(device_, window_)) {
+    case SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM: format = SDL_PIXELFORMAT_BGRA32; break;
+    case SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM: format = SDL_PIXELFORMAT_RGBA32; break;
+    default:
+        std::cerr << "GPU: capture not supported for this swapchain format.\n";
+        return;
+    }
+
+    const Uint8* src = (const Uint8*)SDL_MapGPUTransferBuffer(device_, rb.buffer, false);
+    SDL_Surface* frame = src ? SDL_CreateSurface((int)rb.width, (int)rb.height, format) : nullptr;
+    if (frame) {
+        const size_t rowBytes = (size_t)rb.width * 4;
+        for (Uint32 y = 0; y < rb.height; ++y) {
+            std::memcpy((Uint8*)frame->pixels + (size_t)y * frame->pitch,
+                        src + (size_t)y * rowBytes, rowBytes);
+        }
+    }
+    if (src) SDL_UnmapGPUTransferBuffer(device_, rb.buffer);
+    if (frame) captureSink_->Submit(frame);
+}
+
+bool GpuSpriteRenderer::EndFrame()
+{
+    Uint32 count = (Uint32)instances_.size();
+    if (count > 0 && !EnsureCapacity(count)) count = 0;
+
+    spritesLastFrame_ = count;
+    drawsLastFrame_   = 0;
+    bindsLastFrame_   = 0;
+    targetSwitchesLastFrame_ = 0;
+    uploadedLastFrame_ = uploadedPending_;
+    uploadedPending_   = 0;
+
+    SDL_GPUCommandBuffer* cmd = SDL_AcquireGPUCommandBuffer(device_);
+    if (!cmd) {
+        std::cerr << "GPU: SDL_AcquireGPUCommandBuffer failed: " << SDL_GetError() << "\n";
+        instances_.clear();
+        batches_.clear();
+        return false;
+    }
+
+    SDL_GPUTexture* swapchain = nullptr;
+    Uint32 swapW = 0, swapH = 0;
+    if (!SDL_WaitAndAcquireGPUSwapchainTexture(cmd, window_, &swapchain, &swapW, &swapH)) {
+        std::cerr << "GPU: swapchain acquire failed: " << SDL_GetError() << "\n";
+        SDL_CancelGPUCommandBuffer(cmd);
+        instances_.clear();
+        batches_.clear();
+        return false;
+    }
+
+    // A capture from kFramesInFlight frames ago is in this slot
+    Readback& readback = readbacks_[frameSlot_];
+    if (readback.pending) {
+        SDL_GPUFence*& fence = fences_[frameSlot_];
+        if (fence) {
+            SDL_WaitForGPUFences(device_, true, &fence, 1);
+            SDL_ReleaseGPUFence(device_, fence);
+            fence = nullptr;
+        }
+        DeliverCapture(frameSlot_);
+    }
+
+    if (swapchain && count > 0) {
+        // Reuse this ring slot only once the GPU is done with it
+        SDL_GPUFence*& fence = fences_[frameSlot_];
+        if (fence) {
+            SDL_WaitForGPUFences(device_, true, &fence, 1);
+            SDL_ReleaseGPUFence(device_, fence);
+            fence = nullptr;
+        }
+
+        const Uint32 bytes  = count * (Uint32)sizeof(GpuSpriteInstance);
+        const Uint32 offset = frameSlot_ * capacity_ * (Uint32)sizeof(GpuSpriteInstance);
+
+        Uint8* mapped = (Uint8*)SDL_MapGPUTransferBuffer(device_, transfer_, false);
+        if (mapped) {
+            std::memcpy(mapped + offset, instances_.data(), bytes);
+            SDL_UnmapGPUTransferBuffer(device_, transfer_);
+
+            SDL_GPUCopyPass* copy = SDL_BeginGPUCopyPass(cmd);
+            SDL_GPUTransferBufferLocation src{ transfer_, offset };
+            SDL_GPUBufferRegion dst{ storage_, 0, bytes };
+            SDL_UploadToGPUBuffer(copy, &src, &dst, true); // cycle: last frame may still read it
+            SDL_EndGPUCopyPass(copy);
+            uploadedLastFrame_ += bytes;
+        } else {
+            count = 0;
+        }
+    }
+
+    // Draw straight to the swapchain, or to the smaller scene target.
+    // Captured frames always go through scene_, which can be downloaded.
+    SDL_GPUTexture* target = swapchain;
+    const bool capture = captureThisFrame_;
+    captureThisFrame_ = false;
+    if (swapchain && (resScale_ < 1.f || capture)) {
+        Uint32 w = (Uint32)std::max(1L, std::lround(swapW * resScale_));
+        Uint32 h = (Uint32)std::max(1L, std::lround(swapH * resScale_));
+        if (EnsureScene(w, h)) target = scene_;
+    }
+
+    if (swapchain) {
+        SDL_GPUColorTargetInfo colorTarget{};
+        colorTarget.texture     = target;
+        colorTarget.clear_color = clearColor_;
+        colorTarget.load_op     = SDL_GPU_LOADOP_CLEAR;
+        colorTarget.store_op    = SDL_GPU_STOREOP_STORE;
+
+        SDL_GPURenderPass* pass = SDL_BeginGPURenderPass(cmd, &colorTarget, 1, nullptr);
+        if (count > 0) {
+            const float frame[4] = { 2.f / kViewW, 2.f / kViewH, 0.f, 0.f };
+            SDL_PushGPUVertexUniformData(cmd, 0, frame, sizeof(frame));
+
+            SDL_BindGPUVertexStorageBuffers(pass, 0, &storage_, 1);
+
+            SDL_GPUTexture*          bound    = nullptr;
+            SDL_GPUGraphicsPipeline* boundPso = nullptr;
+            for (const Batch& b : batches_) {
+                SDL_GPUGraphicsPipeline* pso = b.premultiplied ? premulPipeline_ : pipeline_;
+                if (pso != boundPso) SDL_BindGPUGraphicsPipeline(pass, pso);
+                boundPso = pso;
+                SDL_GPUTextureSamplerBinding binding{ b.texture, b.wrap ? wrapSampler_ : sampler_ };
+                SDL_BindGPUFragmentSamplers(pass, 0, &binding, 1);
+                SDL_DrawGPUPrimitives(pass, 6, b.count, 0, b.first);
+                ++drawsLastFrame_;
+                if (b.texture != bound) ++bindsLastFrame_;
+                bound = b.texture;
+            }
+        }
+        SDL_EndGPURenderPass(pass);
+
+        if (capture && target == scene_ && EnsureReadback(frameSlot_, sceneW_ * sceneH_ * 4)) {
+            SDL_GPUCopyPass* copy = SDL_BeginGPUCopyPass(cmd);
+            SDL_GPUTextureRegion src{};
+            src.texture = scene_;
+            src.w = sceneW_;
+            src.h = sceneH_;
+            src.d = 1;
+            SDL_GPUTextureTransferInfo dst{};
+            dst.transfer_buffer = readback.buffer;
+            SDL_DownloadFromGPUTexture(copy, &src, &dst);
+            SDL_EndGPUCopyPass(copy);
+
+            readback.width   = sceneW_;
+            readback.height  = sceneH_;
+            readback.pending = true;
+        }
+
+        if (target != swapchain) {
+            ++targetSwitchesLastFrame_;
+            SDL_GPUBlitInfo blit{};
+            blit.source      = SDL_GPUBlitRegion{ scene_, 0, 0, 0, 0, sceneW_, sceneH_ };
+            blit.destination = SDL_GPUBlitRegion{ swapchain, 0, 0, 0, 0, swapW, swapH };
+            blit.load_op     = SDL_GPU_LOADOP_DONT_CARE;
+            blit.filter      = SDL_GPU_FILTER_LINEAR;
+            SDL_BlitGPUTexture(cmd, &blit);
+        }
+    }
+
+    SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    if (fences_[frameSlot_]) SDL_ReleaseGPUFence(device_, fences_[frameSlot_]);
+    fences_[frameSlot_] = fence;
+    frameSlot_ = (frameSlot_ + 1) % kFramesInFlight;
+
+    instances_.clear();
+    batches_.clear();
+    return fence != nullptr;
+}
@@ -0,0 +1,141 @@
+// src/gpu_renderer.h - SDL_GPU sprite renderer (instanced quads)
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+class FrameCapture;
+
+// One sprite as the vertex shader sees it (std430, four vec4s).
+// Must match SpriteInstance in shaders/sprite.vert.
+struct GpuSpriteInstance
+{
+    float dst[4];   // x, y, w, h in view pixels
+    float uv[4];    // u0, v0, u1, v1
+    float rot[4];   // cos(angle), sin(angle), 0, 0
+    float color[4]; // RGBA multiplier
+};
+
+// Alternative to SDL_Renderer built on SDL_gpu.h. Sprites queued during a
+// frame are written into a persistent, fenced transfer-buffer ring,
+// uploaded to one storage buffer, and drawn as instanced 6-vertex quads
+// inside a single render pass: one draw per run of sprites sharing a
+// texture. Needs SPIR-V shaders (shaders/sprite.*.spv), so it runs on
+// Vulkan, including Mesa's lavapipe.
+class GpuSpriteRenderer
+{
+public:
+    // Create the device, claim `window` and build the pipeline. Returns
+    // false (after cleaning up) if anything is unavailable, so the caller
+    // can fall back to SDL_Renderer.
+    bool Init(SDL_Window* window, bool vsync);
+    void Shutdown();
+
+    bool VSyncEnabled() const { return vsync_; }
+
+    // Upload a surface as a sampled texture. The surface is not freed.
+    // RGBA32 and BGRA32 (the cooked format) go up as they are; anything
+    // else is converted first.
+    SDL_GPUTexture* CreateTexture(SDL_Surface* surf);
+    void            ReleaseTexture(SDL_GPUTexture* tex);
+
+    void SetClearColor(SDL_FColor color) { clearColor_ = color; }
+
+    // Below 1, frames are drawn into a smaller offscreen texture and
+    // blitted (linear filter) onto the swapchain.
+    void SetResolutionScale(float scale) { resScale_ = scale; }
+
+    // Queue a sprite. tex == nullptr draws a solid quad in `color`.
+    // With `wrap`, uv outside [0, 1] repeats the texture (tiled layers).
+    // `premultiplied` textures blend as SDL_BLENDMODE_BLEND_PREMULTIPLIED
+    // (tint them with opaque colours only).
+    // Consecutive sprites with the same texture share one instanced draw.
+    void DrawSprite(SDL_GPUTexture* tex, const SDL_FRect& dst,
+                    const SDL_FRect& uv = SDL_FRect{ 0.f, 0.f, 1.f, 1.f },
+                    float angleDeg = 0.f,
+                    SDL_FColor color = SDL_FColor{ 1.f, 1.f, 1.f, 1.f },
+                    bool wrap = false, bool premultiplied = false);
+
+    // Copy the next frame into a readback buffer of the frame ring. It is
+    // mapped and handed to `sink` when that ring slot comes round again
+    // (kFramesInFlight frames later, when its fence has long signalled),
+    // or in Shutdown(), so `sink` must outlive the renderer.
+    void CaptureNextFrame(FrameCapture& sink);
+
+    // Upload everything queued, record the frame's single render pass and
+    // submit it for presentation.
+    bool EndFrame();
+
+    Uint32 SpritesLastFrame() const { return spritesLastFrame_; }
+    Uint32 DrawsLastFrame() const   { return drawsLastFrame_; }
+    Uint32 BindsLastFrame() const   { return bindsLastFrame_; }
+    Uint32 TargetSwitchesLastFrame() const { return targetSwitchesLastFrame_; }
+    // Instance data plus textures uploaded since the previous frame
+    Uint64 UploadedLastFrame() const { return uploadedLastFrame_; }
+
+private:
+    static constexpr Uint32 kFramesInFlight = 3;
+
+    struct Batch
+    {
+        SDL_GPUTexture* texture;
+        bool            wrap;
+        bool            premultiplied;
+        Uint32          first;
+        Uint32          count;
+    };
+
+    bool CreatePipelines();
+    bool EnsureCapacity(Uint32 sprites);
+    bool EnsureScene(Uint32 width, Uint32 height);
+    bool EnsureReadback(Uint32 slot, Uint32 bytes);
+    void DeliverCapture(Uint32 slot); // after the slot's fence has signalled
+
+    SDL_GPUDevice*           device_   = nullptr;
+    SDL_Window*              window_   = nullptr;
+    SDL_GPUGraphicsPipeline* pipeline_ = nullptr;
+    SDL_GPUGraphicsPipeline* premulPipeline_ = nullptr; // src factor ONE
+    SDL_GPUSampler*          sampler_  = nullptr;
+    SDL_GPUSampler*          wrapSampler_ = nullptr; // repeat, for tiled layers
+    SDL_GPUTexture*          white_    = nullptr; // 1x1 for untextured quads
+    bool                     vsync_    = false;
+
+    // Instance storage on the GPU, and the CPU-visible upload ring that
+    // feeds it: kFramesInFlight slots of `capacity_` instances each.
+    SDL_GPUBuffer*         storage_   = nullptr;
+    SDL_GPUTransferBuffer* transfer_  = nullptr;
+    Uint32                 capacity_  = 0;
+    SDL_GPUFence*          fences_[kFramesInFlight] = {};
+    Uint32                 frameSlot_ = 0;
+
+    SDL_FColor clearColor_{ 18 / 255.f, 18 / 255.f, 28 / 255.f, 1.f };
+
+    // Reduced-resolution colour target for dynamic resolution
+    float           resScale_ = 1.f;
+    SDL_GPUTexture* scene_    = nullptr;
+    Uint32          sceneW_   = 0;
+    Uint32          sceneH_   = 0;
+
+    // Frame capture: one download buffer per ring slot
+    struct Readback
+    {
+        SDL_GPUTransferBuffer* buffer  = nullptr;
+        Uint32                 size    = 0;
+        Uint32                 width   = 0;
+        Uint32                 height  = 0;
+        bool                   pending = false; // holds a frame not yet delivered
+    };
+    Readback      readbacks_[kFramesInFlight];
+    FrameCapture* captureSink_      = nullptr;
+    bool          captureThisFrame_ = false;
+
+    std::vector<GpuSpriteInstance> instances_;
+    std::vector<Batch>             batches_;
+
+    Uint32 spritesLastFrame_ = 0;
+    Uint32 drawsLastFrame_   = 0;
+    Uint32 bindsLastFrame_   = 0;
+    Uint32 targetSwitchesLastFrame_ = 0;
+    Uint64 uploadedLastFrame_ = 0;
+    Uint64 uploadedPending_   = 0; // texture uploads not yet counted in a frame
+};
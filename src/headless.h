@@ -0,0 +1,21 @@
+// src/headless.h - Run the simulation with no window or renderer
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+
+struct HeadlessOptions
+{
+    int    tickRate = 120;
+    Uint64 ticks    = 1000000; // how many simulation steps to run
+
+    std::string replayPath; // play this replay instead of scripted input
+    std::string recordPath; // save the inputs that were run to this file
+};
+
+// Step the player/gravity/wall simulation as fast as the CPU allows and
+// print steps per second. With a replay, its tick rate and length
+// override tickRate/ticks and the final state is checked against it.
+// Does not initialise the SDL video subsystem. Returns the process exit
+// code.
+int RunHeadless(const HeadlessOptions& opts);
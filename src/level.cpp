@@ -0,0 +1,380 @@
+// src/level.cpp - Level layout (static walls), streamed in fixed-size chunks
+#include "level.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "sim.h"
+
+// Edges closer than this are considered touching when merging
+static constexpr float kMergeEps = 0.001f;
+
+static bool NearlyEqual(float a, float b)
+{
+    return std::fabs(a - b) <= kMergeEps;
+}
+
+// One merge pass. With `horizontal`, rects on the same row (equal y and
+// h) whose x ranges touch or overlap are joined; otherwise rects in the
+// same column (equal x and w) are joined along y.
+static std::vector<SDL_FRect> MergePass(std::vector<SDL_FRect> rects, bool horizontal)
+{
+    // Sort key: (row/column identity, position along the merge axis)
+    std::sort(rects.begin(), rects.end(), [horizontal](const SDL_FRect& a, const SDL_FRect& b) {
+        if (horizontal) {
+            if (a.y != b.y) return a.y < b.y;
+            if (a.h != b.h) return a.h < b.h;
+            return a.x < b.x;
+        }
+        if (a.x != b.x) return a.x < b.x;
+        if (a.w != b.w) return a.w < b.w;
+        return a.y < b.y;
+    });
+
+    std::vector<SDL_FRect> out;
+    out.reserve(rects.size());
+
+    for (const SDL_FRect& r : rects) {
+        if (!out.empty()) {
+            SDL_FRect& cur = out.back();
+            if (horizontal && NearlyEqual(cur.y, r.y) && NearlyEqual(cur.h, r.h) &&
+                r.x <= cur.x + cur.w + kMergeEps) {
+                cur.w = std::max(cur.x + cur.w, r.x + r.w) - cur.x;
+                continue;
+            }
+            if (!horizontal && NearlyEqual(cur.x, r.x) && NearlyEqual(cur.w, r.w) &&
+                r.y <= cur.y + cur.h + kMergeEps) {
+                cur.h = std::max(cur.y + cur.h, r.y + r.h) - cur.y;
+                continue;
+            }
+        }
+        out.push_back(r);
+    }
+    return out;
+}
+
+std::vector<SDL_FRect> MergeColliders(const std::vector<SDL_FRect>& rects)
+{
+    return MergePass(MergePass(rects, true), false);
+}
+
+// ----------------------------------------------------------------------
+// Chunk decoding
+// ----------------------------------------------------------------------
+static constexpr float kTileW = 64.f;
+static constexpr float kTileH = 40.f;
+
+// Integer hash (lowbias32) for per-chunk layout decisions
+static Uint32 Hash(Uint32 x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+size_t LevelChunk::Bytes() const
+{
+    return sizeof(LevelChunk)
+         + walls.capacity() * sizeof(SDL_FRect)
+         + colliders.capacity() * sizeof(SDL_FRect)
+         + batch.capacity() * sizeof(DrawCmd)
+         + grid.Bytes() + wallGrid.Bytes();
+}
+
+std::unique_ptr<LevelChunk> DecodeChunk(const LevelLayout& layout, int index,
+                                        const DrawCmd& wallStyle)
+{
+    auto chunk = std::make_unique<LevelChunk>();
+    chunk->index  = index;
+    chunk->bounds = SDL_FRect{ index * kChunkW, 0.f, kChunkW, layout.height };
+
+    std::vector<SDL_FRect>& walls = chunk->walls;
+    const float x0 = chunk->bounds.x;
+    const float h  = layout.height;
+
+    // Floor and ceiling
+    for (float x = x0; x < x0 + kChunkW; x += kTileW) {
+        walls.push_back(SDL_FRect{ x, h - kTileH, kTileW, kTileH });
+        walls.push_back(SDL_FRect{ x, 0.f, kTileW, kTileH });
+    }
+
+    if (index == 0) {
+        // Hand-placed platforms around the spawn point
+        walls.push_back(SDL_FRect{ x0 + 200.f, h - 160.f, 128.f, 32.f });
+        walls.push_back(SDL_FRect{ x0 + 360.f, h - 260.f, 128.f, 32.f });
+    } else {
+        // One or two platforms, each inside its own half of the chunk so
+        // they never overlap
+        const Uint32 r     = Hash(layout.seed ^ ((Uint32)index * 2654435761u));
+        const int    count = 1 + (int)(r & 1u);
+        for (int k = 0; k < count; ++k) {
+            const Uint32 rk    = Hash(r + (Uint32)k);
+            const float  w     = (rk & 1u) ? 128.f : 192.f;
+            const int    slots = (int)((kChunkW * 0.5f - w) / kTileW) + 1;
+            const int    rows  = (int)((h - 320.f) / 20.f) + 1;
+            const float  x     = x0 + k * kChunkW * 0.5f + kTileW * (float)((rk >> 1) % (Uint32)slots);
+            const float  y     = 120.f + 20.f * (float)((rk >> 8) % (Uint32)rows);
+            walls.push_back(SDL_FRect{ x, y, w, 32.f });
+        }
+    }
+
+    chunk->colliders = MergeColliders(walls);
+    chunk->grid.Build(chunk->colliders);
+    chunk->wallGrid.Build(walls);
+
+    chunk->batch.reserve(walls.size());
+    for (const SDL_FRect& w : walls) {
+        DrawCmd cmd = wallStyle;
+        cmd.dst = w;
+        chunk->batch.push_back(cmd);
+    }
+    return chunk;
+}
+
+// ----------------------------------------------------------------------
+// Level
+// ----------------------------------------------------------------------
+Level::Level(const LevelLayout& layout)
+    : layout_(layout)
+{
+    bounds_ = SDL_FRect{ 0.f, 0.f, layout_.chunkCount * kChunkW, layout_.height };
+    chunks_.resize((size_t)layout_.chunkCount);
+    queued_.assign((size_t)layout_.chunkCount, false);
+    wallStyle_.color = SDL_FColor{ 120 / 255.f, 120 / 255.f, 120 / 255.f, 1.f };
+}
+
+Level::~Level()
+{
+    if (thread_) {
+        SDL_LockMutex(mutex_);
+        quit_ = true;
+        SDL_SignalCondition(wake_);
+        SDL_UnlockMutex(mutex_);
+        SDL_WaitThread(thread_, nullptr);
+    }
+    if (wake_)  SDL_DestroyCondition(wake_);
+    if (mutex_) SDL_DestroyMutex(mutex_);
+}
+
+bool Level::StartStreaming()
+{
+    if (thread_) return true;
+
+    mutex_ = SDL_CreateMutex();
+    wake_  = SDL_CreateCondition();
+    if (mutex_ && wake_) {
+        thread_ = SDL_CreateThread(LoaderMain, "level-loader", this);
+    }
+    if (!thread_) {
+        std::cerr << "Level: cannot start loader thread: " << SDL_GetError()
+                  << " - chunks load on demand.\n";
+        return false;
+    }
+    return true;
+}
+
+int Level::LoaderMain(void* self)
+{
+    Level& level = *(Level*)self;
+
+    SDL_LockMutex(level.mutex_);
+    for (;;) {
+        while (!level.quit_ && level.requests_.empty()) {
+            SDL_WaitCondition(level.wake_, level.mutex_);
+        }
+        if (level.quit_) break;
+
+        int index = level.requests_.front();
+        level.requests_.pop_front();
+
+        // Decode without holding the lock; layout_ doesn't change while
+        // the thread runs, and Adopt() restyles chunks if wallStyle_ has.
+        const DrawCmd style = level.wallStyle_;
+        SDL_UnlockMutex(level.mutex_);
+        std::unique_ptr<LevelChunk> chunk = DecodeChunk(level.layout_, index, style);
+        SDL_LockMutex(level.mutex_);
+
+        level.finished_.push_back(std::move(chunk));
+    }
+    SDL_UnlockMutex(level.mutex_);
+    return 0;
+}
+
+bool Level::ChunkRange(const SDL_FRect& area, int margin, int& first, int& last) const
+{
+    first = (int)std::floor(area.x / kChunkW) - margin;
+    last  = (int)std::floor((area.x + area.w) / kChunkW) + margin;
+    first = std::max(first, 0);
+    last  = std::min(last, layout_.chunkCount - 1);
+    return first <= last;
+}
+
+// Everything but the position comes from the style
+static void Restyle(LevelChunk& chunk, const DrawCmd& style)
+{
+    for (DrawCmd& cmd : chunk.batch) {
+        const SDL_FRect dst = cmd.dst;
+        cmd = style;
+        cmd.dst = dst;
+    }
+}
+
+void Level::SetWallStyle(const DrawCmd& style)
+{
+    if (mutex_) SDL_LockMutex(mutex_);
+    wallStyle_ = style;
+    if (mutex_) SDL_UnlockMutex(mutex_);
+
+    for (const std::unique_ptr<LevelChunk>& chunk : chunks_) {
+        if (chunk) Restyle(*chunk, wallStyle_);
+    }
+}
+
+void Level::Adopt(std::unique_ptr<LevelChunk> chunk)
+{
+    const int index = chunk->index;
+    queued_[(size_t)index] = false;
+    if (chunks_[(size_t)index]) return; // Require() got there first
+
+    // May have been decoded on the loader thread before a SetWallStyle()
+    Restyle(*chunk, wallStyle_);
+
+    residentBytes_ += chunk->Bytes();
+    ++residentCount_;
+    chunks_[(size_t)index] = std::move(chunk);
+
+    peakResident_ = std::max(peakResident_, residentCount_);
+    peakBytes_    = std::max(peakBytes_, residentBytes_);
+}
+
+void Level::Evict(int index)
+{
+    std::unique_ptr<LevelChunk>& chunk = chunks_[(size_t)index];
+    if (!chunk) return;
+
+    residentBytes_ -= chunk->Bytes();
+    --residentCount_;
+    chunk.reset();
+    ++evictions_;
+}
+
+void Level::CollectFinished()
+{
+    if (!thread_) return;
+
+    std::vector<std::unique_ptr<LevelChunk>> done;
+    SDL_LockMutex(mutex_);
+    done.swap(finished_);
+    SDL_UnlockMutex(mutex_);
+
+    // A chunk popped by the loader before the focus moved away may land
+    // outside the keep range; Stream() only evicts when the range
+    // changes, so drop it here rather than let it stay resident.
+    const bool haveRange = streamFirst_ <= streamLast_; // Stream() has run
+    for (auto& chunk : done) {
+        ++loadsAsync_;
+        const int index = chunk->index;
+        if (haveRange && (index < streamFirst_ || index > streamLast_)) {
+            queued_[(size_t)index] = false;
+            continue;
+        }
+        Adopt(std::move(chunk));
+    }
+}
+
+void Level::Stream(const SDL_FRect& focus)
+{
+    int keepFirst = 0, keepLast = -1;
+    ChunkRange(focus, kEvictMargin, keepFirst, keepLast);
+
+    const bool moved = keepFirst != streamFirst_ || keepLast != streamLast_;
+    streamFirst_ = keepFirst;
+    streamLast_  = keepLast;
+    CollectFinished(); // against the new keep range
+
+    // Nothing more to do until the focus crosses into another chunk
+    if (!moved) return;
+
+    for (int i = 0; i < layout_.chunkCount; ++i) {
+        if (chunks_[(size_t)i] && (i < keepFirst || i > keepLast)) Evict(i);
+    }
+
+    if (!thread_) return;
+
+    int first = 0, last = -1;
+    ChunkRange(focus, kLoadMargin, first, last);
+
+    SDL_LockMutex(mutex_);
+    // Drop requests the focus has moved away from before they're decoded
+    for (auto it = requests_.begin(); it != requests_.end();) {
+        if (*it < keepFirst || *it > keepLast) {
+            queued_[(size_t)*it] = false;
+            it = requests_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    bool added = false;
+    for (int i = first; i <= last; ++i) {
+        if (chunks_[(size_t)i] || queued_[(size_t)i]) continue;
+        queued_[(size_t)i] = true;
+        requests_.push_back(i);
+        added = true;
+    }
+    if (added) SDL_SignalCondition(wake_);
+    SDL_UnlockMutex(mutex_);
+}
+
+void Level::Require(const SDL_FRect& area)
+{
+    CollectFinished();
+
+    int first = 0, last = -1;
+    if (!ChunkRange(area, 1, first, last)) return;
+
+    for (int i = first; i <= last; ++i) {
+        if (chunks_[(size_t)i]) continue;
+        // Not worth waiting for the loader: decoding a chunk is cheap
+        // next to a missed frame, and a duplicate is dropped in Adopt()
+        ++loadsSync_;
+        Adopt(DecodeChunk(layout_, i, wallStyle_));
+    }
+}
+
+void Level::QueryColliders(const SDL_FRect& area, std::vector<SDL_FRect>& out) const
+{
+    int first = 0, last = -1;
+    if (!ChunkRange(area, 0, first, last)) return;
+
+    static thread_local std::vector<int> candidates;
+    for (int i = first; i <= last; ++i) {
+        const LevelChunk* chunk = chunks_[(size_t)i].get();
+        if (!chunk) continue;
+
+        candidates.clear();
+        chunk->grid.Query(area, candidates);
+        for (int idx : candidates) out.push_back(chunk->colliders[idx]);
+    }
+}
+
+void Level::VisibleChunks(const SDL_FRect& area, std::vector<const LevelChunk*>& out) const
+{
+    int first = 0, last = -1;
+    if (!ChunkRange(area, 0, first, last)) return;
+
+    for (int i = first; i <= last; ++i) {
+        if (chunks_[(size_t)i]) out.push_back(chunks_[(size_t)i].get());
+    }
+}
+
+void Level::Report() const
+{
+    std::cout << "Level streaming: " << loadsAsync_ << " chunks loaded in the background, "
+              << loadsSync_ << " on demand, " << evictions_ << " evicted; peak "
+              << peakResident_ << "/" << layout_.chunkCount << " chunks resident ("
+              << peakBytes_ / 1024 << " KiB)\n";
+}
@@ -0,0 +1,136 @@
+// src/level.h - Level layout (static walls), streamed in fixed-size chunks
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "render_backend.h"
+#include "sim.h"
+#include "spatial_grid.h"
+
+// Chunks are full-height vertical strips of the level. Every tile and
+// platform lies inside a single chunk, so a chunk never needs its
+// neighbours to be complete.
+constexpr float kChunkW = 512.f;
+
+// Everything needed to rebuild any chunk on demand. Small and immutable,
+// so the loader thread can read it without locking.
+struct LevelLayout
+{
+    int    chunkCount = 64;     // level width in chunks
+    float  height     = kViewH; // level height (one screen)
+    Uint32 seed       = 0x464D4C56u;
+};
+
+// One resident piece of the level
+struct LevelChunk
+{
+    int       index = 0;
+    SDL_FRect bounds{};
+
+    std::vector<SDL_FRect> walls;     // one rect per wall tile
+    std::vector<SDL_FRect> colliders; // walls merged into maximal rects
+    SpatialGrid            grid;      // index over colliders
+    SpatialGrid            wallGrid;  // index over walls, for view culling
+    std::vector<DrawCmd>   batch;     // walls[i] as a draw command, world space
+
+    // Approximate heap footprint, for the residency budget report
+    size_t Bytes() const;
+};
+
+// Generate chunk `index` of `layout`: tiles, merged colliders, grids and
+// the render batch (every wall drawn with `wallStyle`). Pure, so it can
+// run on any thread.
+std::unique_ptr<LevelChunk> DecodeChunk(const LevelLayout& layout, int index,
+                                        const DrawCmd& wallStyle);
+
+// The level as a window of resident chunks around a focus rect. Chunks
+// are decoded on a loader thread and evicted once they are far away, so
+// memory stays bounded however long the level is.
+//
+// Collision must never depend on load timing: call Require() for the
+// area a simulation tick can reach before stepping, which decodes any
+// missing chunk synchronously.
+class Level
+{
+public:
+    explicit Level(const LevelLayout& layout = LevelLayout{});
+    ~Level();
+
+    Level(const Level&) = delete;
+    Level& operator=(const Level&) = delete;
+
+    const LevelLayout& Layout() const { return layout_; }
+    const SDL_FRect&   Bounds() const { return bounds_; }
+
+    // How walls are drawn in chunk batches. Resident chunks are restyled
+    // at once, so this can change when the wall sprite finishes loading.
+    void SetWallStyle(const DrawCmd& style);
+
+    // Start the loader thread. Without it, chunks only load in Require().
+    bool StartStreaming();
+
+    // Per frame: adopt finished chunks, queue loads for chunks within
+    // kLoadMargin of `focus`, evict chunks beyond kEvictMargin.
+    void Stream(const SDL_FRect& focus);
+
+    // Make sure every chunk overlapping `area` (widened by one chunk, more
+    // than a tick can move) is resident, decoding on this thread if needed.
+    void Require(const SDL_FRect& area);
+
+    // Colliders of resident chunks overlapping `area`, appended to `out`
+    void QueryColliders(const SDL_FRect& area, std::vector<SDL_FRect>& out) const;
+
+    // Resident chunks overlapping `area`, appended to `out`
+    void VisibleChunks(const SDL_FRect& area, std::vector<const LevelChunk*>& out) const;
+
+    int    ResidentChunks() const { return residentCount_; }
+    size_t ResidentBytes() const  { return residentBytes_; }
+
+    // Print a one-line streaming summary to stdout.
+    void Report() const;
+
+private:
+    static constexpr int kLoadMargin  = 1; // chunks kept loaded beyond the focus
+    static constexpr int kEvictMargin = 2; // chunks kept before eviction
+
+    static int LoaderMain(void* self);
+
+    // Chunk index range [first, last] overlapping `area`, clamped
+    bool ChunkRange(const SDL_FRect& area, int margin, int& first, int& last) const;
+    void Adopt(std::unique_ptr<LevelChunk> chunk);
+    void Evict(int index);
+    void CollectFinished();
+
+    LevelLayout layout_;
+    SDL_FRect   bounds_{};
+    DrawCmd     wallStyle_;
+
+    std::vector<std::unique_ptr<LevelChunk>> chunks_;  // by index; null = not resident
+    std::vector<bool>                        queued_;  // load requested, not adopted
+    int    residentCount_ = 0;
+    size_t residentBytes_ = 0;
+    int    streamFirst_   = 0;  // keep range of the last Stream() call
+    int    streamLast_    = -1;
+
+    // Loader thread: requests in, decoded chunks out, both under mutex_
+    SDL_Thread*    thread_  = nullptr;
+    SDL_Mutex*     mutex_   = nullptr;
+    SDL_Condition* wake_    = nullptr;
+    bool           quit_    = false;
+    std::deque<int>                          requests_;
+    std::vector<std::unique_ptr<LevelChunk>> finished_;
+
+    // Stats
+    Uint64 loadsAsync_   = 0;
+    Uint64 loadsSync_    = 0; // Require() had to decode on the caller's thread
+    Uint64 evictions_    = 0;
+    int    peakResident_ = 0;
+    size_t peakBytes_    = 0;
+};
+
+// Greedily merge touching or overlapping rects that together form a
+// larger rectangle: first along rows, then along columns.
+std::vector<SDL_FRect> MergeColliders(const std::vector<SDL_FRect>& rects);
@@ -1,269 +1,505 @@
-// src/main.cpp - SDL3 FlipMan with BMP assets (player, wall, background + rotation)
+// src/main.cpp - SDL3 FlipMan with PNG assets (player, wall, parallax layers + rotation)
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
-// Helper: load a BMP from disk and turn it into a texture
-SDL_Texture* LoadBMPTexture(SDL_Renderer* renderer, const char* path)
+#include "asset_loader.h"
+#include "atlas.h"
+#include "camera.h"
+#include "dynamic_resolution.h"
+#include "frame_capture.h"
+#include "frame_pacer.h"
+#include "headless.h"
+#include "level.h"
+#include "particles.h"
+#include "render_backend.h"
+#include "render_stats.h"
+#include "replay.h"
+#include "scene.h"
+#include "sim.h"
+#include "texture_cache.h"
+
+// Flip bursts, landing dust and a running trail, from one simulation tick
+void EmitPlayerEffects(const PlayerState& before, const PlayerState& after,
+                       const TickInput& input, ParticleSystem& particles)
 {
-    SDL_Surface* surf = SDL_LoadBMP(path);
-    if (!surf) {
-        std::cerr << "SDL_LoadBMP failed for '" << path << "': "
-                  << SDL_GetError() << "\n";
-        return nullptr;
+    const SDL_FRect& r = after.rect;
+    // Feet are on the side gravity pulls towards
+    const float footY = after.gravityDir > 0.f ? r.y + r.h : r.y;
+    const float up    = after.gravityDir > 0.f ? -90.f : 90.f; // away from the floor
+
+    ParticleBurst burst;
+    if (input.flip) {
+        burst.origin = SDL_FPoint{ r.x + r.w * 0.5f, r.y + r.h * 0.5f };
+        burst.count  = 64;
+        burst.color  = SDL_FColor{ 0.4f, 0.9f, 1.f, 1.f };
+        particles.Emit(burst);
     }
 
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (!tex) {
-        std::cerr << "SDL_CreateTextureFromSurface failed for '" << path
-                  << "': " << SDL_GetError() << "\n";
+    // Landed: was falling fast along gravity, now stopped
+    if (before.vy * before.gravityDir > 200.f && after.vy == 0.f) {
+        burst.origin   = SDL_FPoint{ r.x + r.w * 0.5f, footY };
+        burst.count    = 24;
+        burst.angle    = up;
+        burst.spread   = 150.f;
+        burst.speedMax = 120.f;
+        burst.lifeMax  = 0.5f;
+        burst.color    = SDL_FColor{ 0.8f, 0.75f, 0.65f, 1.f };
+        particles.Emit(burst);
     }
 
-    SDL_DestroySurface(surf); // SDL3: destroy surface
-    return tex;
+    // Running on the ground: a thin trail from the trailing foot
+    if (after.vx != 0.f && after.vy == 0.f) {
+        burst.origin   = SDL_FPoint{ after.vx > 0.f ? r.x : r.x + r.w, footY };
+        burst.count    = 1;
+        burst.angle    = up;
+        burst.spread   = 90.f;
+        burst.speedMin = 10.f;
+        burst.speedMax = 40.f;
+        burst.lifeMin  = 0.2f;
+        burst.lifeMax  = 0.4f;
+        burst.color    = SDL_FColor{ 0.9f, 0.9f, 0.9f, 0.7f };
+        particles.Emit(burst);
+    }
 }
 
 int main(int argc, char** argv)
 {
-    std::cout << "SDL3 FlipMan + BMP assets + rotation: start\n";
+    std::cout << "SDL3 FlipMan + PNG assets + rotation: start\n";
+
+    // Simulation tick rate in Hz: --tick-rate <hz>
+    // Frame pacing: --pacing vsync|capped|uncapped, --fps <hz> for capped
+    // No window:   --headless [--ticks <n>]
+    // Replays:     --record <file>, --replay <file>
+    // Rendering:   --backend sdl|software|gpu|null (--gpu = --backend gpu),
+    //              --bench-sprites <n> extra sprites per frame,
+    //              --bench-particles <n> particles kept alive on screen
+    // Resolution:  --min-res-scale <0.1..1> floor for dynamic resolution,
+    //              --fixed-res to always render at window size
+    // Stats:       --stats shows the renderer overlay (F3 toggles it),
+    //              --stats-csv <file> writes per-frame counters as it runs
+    // Textures:    --texture-budget <MiB> of unused textures kept cached
+    // Capture:     --capture <prefix> saves every frame as <prefix>NNNNNN.bmp,
+    //              F12 saves the next one (prefix "screenshot_" by default)
+    int        tickRate  = 120;
+    PacingMode pacing    = PacingMode::VSync;
+    int        targetFps = 60;
+    bool       headless  = false;
+    Uint64     ticks     = 1000000;
+    std::string recordPath;
+    std::string replayPath;
+    RenderBackendKind backendKind  = DefaultRenderBackend();
+    int               benchSprites = 0;
+    int               benchParticles = 0;
+    float             minResScale  = 0.5f;
+    bool              fixedRes     = false;
+    bool              showStats    = false;
+    std::string       statsCsvPath;
+    std::string       capturePrefix;
+    Uint64            textureBudget = 64ull << 20;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = std::atoi(argv[++i]);
+            if (tickRate <= 0 || tickRate > kReplayMaxTickRate) { // replays store a u16
+                std::cerr << "Invalid --tick-rate, using 120 Hz.\n";
+                tickRate = 120;
+            }
+        } else if (std::strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            if (!ParsePacingMode(argv[++i], pacing)) {
+                std::cerr << "Unknown --pacing '" << argv[i] << "', using vsync.\n";
+                pacing = PacingMode::VSync;
+            }
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            targetFps = std::atoi(argv[++i]);
+            if (targetFps <= 0) {
+                std::cerr << "Invalid --fps, using 60.\n";
+                targetFps = 60;
+            }
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            if (!ParseRenderBackend(argv[++i], backendKind)) {
+                std::cerr << "Unknown --backend '" << argv[i] << "', using "
+                          << RenderBackendName(DefaultRenderBackend()) << ".\n";
+                backendKind = DefaultRenderBackend();
+            }
+        } else if (std::strcmp(argv[i], "--gpu") == 0) {
+            backendKind = RenderBackendKind::Gpu;
+        } else if (std::strcmp(argv[i], "--bench-sprites") == 0 && i + 1 < argc) {
+            benchSprites = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--bench-particles") == 0 && i + 1 < argc) {
+            benchParticles = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--min-res-scale") == 0 && i + 1 < argc) {
+            minResScale = (float)std::atof(argv[++i]);
+            if (minResScale <= 0.f || minResScale > 1.f) {
+                std::cerr << "Invalid --min-res-scale, using 0.5.\n";
+                minResScale = 0.5f;
+            }
+        } else if (std::strcmp(argv[i], "--fixed-res") == 0) {
+            fixedRes = true;
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            showStats = true;
+        } else if (std::strcmp(argv[i], "--stats-csv") == 0 && i + 1 < argc) {
+            statsCsvPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) {
+            double mib = std::atof(argv[++i]);
+            if (mib > 0.0 && mib <= 1024.0 * 1024.0) {
+                textureBudget = (Uint64)(mib * 1024 * 1024);
+            } else {
+                std::cerr << "Invalid --texture-budget, using 64 MiB.\n";
+            }
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capturePrefix = argv[++i];
+        }
+    }
+
+    if (headless) {
+        HeadlessOptions opts;
+        opts.tickRate   = tickRate;
+        opts.ticks      = ticks;
+        opts.recordPath = recordPath;
+        opts.replayPath = replayPath;
+        return RunHeadless(opts);
+    }
 
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         std::cerr << "SDL_Init error: " << SDL_GetError() << "\n";
         return 1;
     }
 
-    SDL_Window* window = SDL_CreateWindow("Flip Man - SDL3 (BMP Assets + Rotation)",
-                                          800, 600, 0);
+    SDL_Window* window = SDL_CreateWindow("Flip Man - SDL3 (PNG Assets + Rotation)",
+                                          (int)kViewW, (int)kViewH, 0);
     if (!window) {
         std::cerr << "SDL_CreateWindow error: " << SDL_GetError() << "\n";
         SDL_Quit();
         return 1;
     }
 
-    SDL_Renderer* ren = SDL_CreateRenderer(window, nullptr);
-    if (!ren) {
-        std::cerr << "SDL_CreateRenderer error: " << SDL_GetError() << "\n";
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-        return 1;
+    // Requested backend; anything that fails to start falls back to
+    // SDL_Renderer.
+    const bool wantVSync = (pacing == PacingMode::VSync);
+    std::unique_ptr<RenderBackend> backend = CreateRenderBackend(backendKind);
+    if (!backend->Init(window, wantVSync)) {
+        std::cout << RenderBackendName(backendKind) << " backend unavailable, using SDL_Renderer.\n";
+        backend = CreateRenderBackend(RenderBackendKind::SdlRenderer);
+        if (!backend->Init(window, wantVSync)) {
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            return 1;
+        }
     }
 
     // ------------------------------------------------------------------
-    // Load textures (BMP) from ../assets/
-    // ------------------------------------------------------------------
-    SDL_Texture* texPlayer = LoadBMPTexture(ren, "../assets/player.bmp");
-    SDL_Texture* texWall   = LoadBMPTexture(ren, "../assets/wall.bmp");
-    SDL_Texture* texBg     = LoadBMPTexture(ren, "../assets/background.bmp"); // optional
-
-    if (!texPlayer) std::cout << "player.bmp missing, using green rect.\n";
-    if (!texWall)   std::cout << "wall.bmp missing, using gray rects.\n";
-    if (!texBg)     std::cout << "background.bmp missing, using solid color.\n";
-
-    // ------------------------------------------------------------------
-    // Player / physics
+    // Textures (PNG) from the asset pack or ../assets/, loaded in the background (see
+    // asset_loader.h). The first frames draw the placeholders; each asset
+    // replaces its placeholder as it arrives.
+    // Sprites share one atlas page; background layers are small textures
+    // of their own, repeated across the view, shared through the texture
+    // cache (see texture_cache.h).
     // ------------------------------------------------------------------
-    SDL_FRect player{ 380.f, 520.f, 40.f, 60.f }; // x, y, w, h
-
-    float vx = 0.f;
-    float vy = 0.f;
-
-    const float gravity    = 900.f; // constant magnitude
-    float       gravityDir = 1.f;   // +1 = gravity down, -1 = gravity up
-
-    const float moveSpeed  = 240.f;
+    TextureAtlas atlas;
+    SceneAssets  assets;
+
+    // Parallax layers, back to front (all optional). The slots exist from
+    // the start so each layer keeps its depth whatever order they load in.
+    struct LayerFile
+    {
+        const char* name;
+        float       y, height, factor; // height 0 = one tile high
+    };
+    const LayerFile layerFiles[] = {
+        { "sky",    0.f,            kViewH, 0.f  },
+        { "clouds", 40.f,           0.f,    0.2f },
+        { "hills",  kViewH - 168.f, 0.f,    0.5f },
+    };
+    for (const LayerFile& file : layerFiles) {
+        ParallaxLayer layer;
+        layer.y      = file.y;
+        layer.height = file.height;
+        layer.factor = file.factor;
+        assets.layers.push_back(layer);
+    }
+    assets.layers[0].blend = SDL_BLENDMODE_NONE; // opaque, nothing behind it
 
     // ------------------------------------------------------------------
-    // Player rotation (for flip animation)
+    // Player / physics (see sim.h)
     // ------------------------------------------------------------------
-    float playerAngle      = 0.f;   // current angle in degrees
-    float targetAngle      = 0.f;   // target angle (0 or 180)
-    const float angleSpeed = 720.f; // degrees per second (how fast we rotate)
+    PlayerState prevState;           // state at the previous tick
+    PlayerState currState;           // state at the latest tick
+    bool        flipPending = false; // SPACE pressed, applied on next tick
 
     // ------------------------------------------------------------------
-    // Walls: floor, ceiling, and two platforms
+    // Walls: streamed in chunks around the camera (see level.h)
     // ------------------------------------------------------------------
-    std::vector<SDL_FRect> walls;
-    const float tileW = 64.f;
-    const float tileH = 40.f;
-
-    // Floor (bottom of screen)
-    for (float x = 0.f; x < 800.f; x += tileW) {
-        walls.push_back(SDL_FRect{ x, 600.f - tileH, tileW, tileH });
+    Level level;
+    level.SetWallStyle(WallStyle(assets)); // restyled once the wall sprite loads
+    level.StartStreaming();
+    level.Require(currState.rect); // spawn area, before the first frame
+
+    // The screen-fixed layers don't scroll: rebuild their list and bump the
+    // version only when it changes, so backends can keep their cached copy.
+    DrawList staticList;
+    Uint64   staticVersion = 1;
+    BuildStaticDrawList(assets, staticList);
+    DrawList worldList;
+
+    // Everything comes from assets.pak next to the executable when it's
+    // there (built with the game from the cooked textures, see
+    // tools/pack_assets.cpp and tools/cook_assets.cpp); otherwise from
+    // the loose files in ../assets/.
+    AssetPack pack;
+    const char* basePath = SDL_GetBasePath();
+    if (pack.Open(std::string(basePath ? basePath : "") + "assets.pak")) {
+        std::cout << "Assets: " << pack.Count() << " in '" << pack.Path() << "'"
+                  << (pack.Mapped() ? " (mapped)" : "") << ".\n";
     }
+    AssetLoader loader(&pack, "../assets/");
+    loader.Start();
+    TextureCache textures(*backend, loader, textureBudget);
+
+    int spritesPending = 2;
+    auto onSprite = [&](const char* name, SDL_Surface* surf, const ImageMeta& meta) {
+        atlas.Add(name, surf, meta);
+        if (--spritesPending > 0) return;
+
+        // One atlas build for both, so they share a page
+        atlas.Build(*backend);
+        assets.player = atlas.Find("player");
+        assets.wall   = atlas.Find("wall");
+        textures.SetExternalBytes(atlas.Bytes());
+        level.SetWallStyle(WallStyle(assets));
+        if (!assets.player) std::cout << "player image missing, using green rect.\n";
+        if (!assets.wall)   std::cout << "wall image missing, using gray rects.\n";
+    };
+    loader.Load("player", [&](SDL_Surface* surf, const ImageMeta& meta) {
+        onSprite("player", surf, meta);
+    });
+    loader.Load("wall", [&](SDL_Surface* surf, const ImageMeta& meta) {
+        onSprite("wall", surf, meta);
+    });
+
+    std::vector<AssetId> layerAssets;
+    for (size_t i = 0; i < assets.layers.size(); ++i) {
+        layerAssets.push_back(textures.Intern(layerFiles[i].name));
+        textures.Acquire(layerAssets[i], [&, i](const CachedTexture* tex) {
+            if (!tex) return; // the layer stays empty
+            ParallaxLayer& layer = assets.layers[i];
+            layer.texture = tex->texture;
+            if (tex->meta.premultiplied && layer.blend == SDL_BLENDMODE_BLEND) {
+                layer.blend = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+            }
+            layer.tileW   = (float)tex->w;
+            layer.tileH   = (float)tex->h;
+            if (layer.height <= 0.f) layer.height = layer.tileH;
 
-    // Ceiling (top of screen)
-    for (float x = 0.f; x < 800.f; x += tileW) {
-        walls.push_back(SDL_FRect{ x, 0.f, tileW, tileH });
+            if (layer.factor == 0.f) {
+                BuildStaticDrawList(assets, staticList);
+                ++staticVersion;
+            }
+        });
     }
 
-    // Platforms (middle of level)
-    walls.push_back(SDL_FRect{ 200.f, 600.f - 160.f, 128.f, 32.f });
-    walls.push_back(SDL_FRect{ 500.f, 600.f - 260.f, 128.f, 32.f });
+    Camera camera;
+    camera.SetBounds(level.Bounds());
+
+    // Cosmetic effects, advanced per rendered frame (see particles.h)
+    ParticleSystem particles(std::max<size_t>(20000, (size_t)std::max(benchParticles, 0)));
 
-    Uint64 lastTicks = SDL_GetTicks();
+    // ------------------------------------------------------------------
+    // Replays: play back recorded input, or record what the player does
+    // ------------------------------------------------------------------
+    ReplayReader replay;
+    bool replaying  = false;
+    bool replayDone = false;
+    if (!replayPath.empty()) {
+        replaying = replay.Load(replayPath);
+        if (replaying) tickRate = replay.TickRate();
+    }
+    ReplayWriter recorder(tickRate);
+    bool recording = !recordPath.empty();
+
+    FixedStep  clock(tickRate);
+    FramePacer pacer(window, backend->VSyncActive(), pacing, targetFps);
+
+    // Trade resolution for time when frames run over the pacing budget.
+    // Uncapped has no budget, so it always renders at full size.
+    ResolutionController resolution(fixedRes ? 0 : pacer.PeriodNS(), minResScale);
+    RenderStatsLog statsLog;
+    if (!statsCsvPath.empty()) statsLog.Open(statsCsvPath);
+
+    // Captured frames are read back late and saved on a writer thread
+    const bool   captureAll = !capturePrefix.empty();
+    FrameCapture capture(captureAll ? capturePrefix : "screenshot_");
+    bool         screenshotPending = false;
+    if (captureAll) capture.Start();
+    Uint64 lastNS = SDL_GetTicksNS();
     bool running = true;
 
-    std::cout << "Window created, entering main loop.\n";
+    std::cout << "Window created, entering main loop ("
+              << tickRate << " Hz simulation, "
+              << PacingModeName(pacer.Mode()) << " pacing, "
+              << RenderBackendName(backend->Kind()) << " backend).\n";
 
     while (running) {
+        const Uint64 frameStartNS = SDL_GetTicksNS();
+
         // ---------------- Input ----------------
         SDL_Event e;
         while (SDL_PollEvent(&e)) {
             if (e.type == SDL_EVENT_QUIT) {
                 running = false;
+            } else if (e.type == SDL_EVENT_RENDER_TARGETS_RESET ||
+                       e.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+                // Target texture contents were lost
+                backend->InvalidateCaches();
             } else if (e.type == SDL_EVENT_KEY_DOWN) {
                 if (e.key.key == SDLK_ESCAPE && e.key.down) {
                     running = false;
                 }
                 if (e.key.key == SDLK_SPACE && e.key.down) {
-                    // Flip gravity direction
-                    gravityDir *= -1.f;
-
-                    // Reset vertical velocity to avoid weird residual speeds.
-                    vy = 0.f;
-
-                    // Set target angle based on new gravity direction:
-                    // gravity down  -> upright (0°)
-                    // gravity up    -> upside down (180°)
-                    targetAngle = (gravityDir > 0.f) ? 0.f : 180.f;
-
-                    std::cout << "Gravity flipped. Now "
-                              << (gravityDir > 0 ? "DOWN, " : "UP, ")
-                              << "targetAngle = " << targetAngle << " deg\n";
+                    // Flip gravity on the next simulation tick
+                    flipPending = true;
+                }
+                if (e.key.key == SDLK_F12 && e.key.down && !e.key.repeat) {
+                    screenshotPending = capture.Start();
+                }
+                if (e.key.key == SDLK_F3 && e.key.down && !e.key.repeat) {
+                    showStats = !showStats;
+                    if (!showStats) backend->SetOverlay({});
                 }
             }
         }
 
         int numKeys = 0;
         const bool* kb = SDL_GetKeyboardState(&numKeys);
-        vx = 0.f;
-        if (kb[SDL_SCANCODE_A] || kb[SDL_SCANCODE_LEFT])  vx = -moveSpeed;
-        if (kb[SDL_SCANCODE_D] || kb[SDL_SCANCODE_RIGHT]) vx =  moveSpeed;
-
-        // ---------------- Update ----------------
-        Uint64 nowTicks = SDL_GetTicks();
-        float dt = (nowTicks - lastTicks) / 1000.0f;
-        lastTicks = nowTicks;
-
-        // Safety clamp if the frame spikes
-        if (dt > 0.05f) dt = 0.05f;
-
-        // Animate rotation: move playerAngle toward targetAngle
-        if (playerAngle < targetAngle) {
-            playerAngle += angleSpeed * dt;
-            if (playerAngle > targetAngle) playerAngle = targetAngle;
-        } else if (playerAngle > targetAngle) {
-            playerAngle -= angleSpeed * dt;
-            if (playerAngle < targetAngle) playerAngle = targetAngle;
-        }
+        TickInput input;
+        input.left  = kb[SDL_SCANCODE_A] || kb[SDL_SCANCODE_LEFT];
+        input.right = kb[SDL_SCANCODE_D] || kb[SDL_SCANCODE_RIGHT];
+
+        // ---------------- Update (fixed step) ----------------
+        Uint64 nowNS = SDL_GetTicksNS();
+        const float frameDt = std::min((float)((double)(nowNS - lastNS) / SDL_NS_PER_SECOND), 0.1f);
+        int steps = clock.Advance(nowNS - lastNS);
+        lastNS = nowNS;
+
+        for (int i = 0; i < steps && running; ++i) {
+            input.flip  = flipPending;
+            flipPending = false;
+
+            if (replaying && !replay.Next(input)) {
+                std::cout << "Replay finished.\n";
+                replayDone = true;
+                running    = false;
+                break;
+            }
+            if (recording) recorder.Record(input);
 
-        // Apply gravity
-        vy += gravity * gravityDir * dt;
-
-        // Save previous position before moving (for directional collision)
-        float oldX = player.x;
-        float oldY = player.y;
-
-        // Move
-        player.x += vx * dt;
-        player.y += vy * dt;
-
-        // ---------------- Collision handling ----------------
-        for (const auto& w : walls) {
-            if (SDL_HasRectIntersectionFloat(&player, &w)) {
-                float wallTop    = w.y;
-                float wallBottom = w.y + w.h;
-                float wallLeft   = w.x;
-                float wallRight  = w.x + w.w;
-
-                float overlapLeft   = (player.x + player.w) - wallLeft;
-                float overlapRight  = wallRight - player.x;
-                float overlapTop    = (player.y + player.h) - wallTop;
-                float overlapBottom = wallBottom - player.y;
-
-                float minHoriz = std::min(overlapLeft, overlapRight);
-                float minVert  = std::min(overlapTop, overlapBottom);
-
-                if (minVert < minHoriz) {
-                    // Resolve vertically based on movement direction
-                    if (player.y > oldY) {
-                        // We moved DOWN into the wall -> snap to top
-                        player.y = wallTop - player.h;
-                        vy = 0.f;
-                    } else if (player.y < oldY) {
-                        // We moved UP into the wall -> snap to bottom
-                        player.y = wallBottom;
-                        vy = 0.f;
-                    }
-                } else {
-                    // Resolve horizontally
-                    if (player.x > oldX) {
-                        // moved right
-                        player.x = wallLeft - player.w;
-                    } else if (player.x < oldX) {
-                        // moved left
-                        player.x = wallRight;
-                    }
-                    vx = 0.f;
-                }
+            prevState = currState;
+            level.Require(currState.rect);
+            StepPlayer(currState, input, level, clock.Dt());
+
+            EmitPlayerEffects(prevState, currState, input, particles);
+            if (input.flip) {
+                std::cout << "Gravity flipped. Now "
+                          << (currState.gravityDir > 0 ? "DOWN, " : "UP, ")
+                          << "targetAngle = " << currState.targetAngle << " deg\n";
             }
         }
 
-        // Clamp horizontally within the screen
-        if (player.x < 0.f) player.x = 0.f;
-        if (player.x + player.w > 800.f) player.x = 800.f - player.w;
+        // Interpolate between the last two ticks for smooth presentation
+        PlayerState view = LerpPlayer(prevState, currState, clock.Alpha());
 
         // ---------------- Render ----------------
-        if (!texBg) {
-            SDL_SetRenderDrawColor(ren, 18, 18, 28, SDL_ALPHA_OPAQUE);
-            SDL_RenderClear(ren);
-        } else {
-            SDL_FRect bgRect{ 0.f, 0.f, 800.f, 600.f };
-            SDL_RenderTexture(ren, texBg, nullptr, &bgRect);
+        loader.Update(); // swaps in assets that finished loading
+        camera.Follow(view.rect);
+        level.Stream(camera.View());
+        if (benchParticles > 0) {
+            // Fountain across the view, topped up to the requested count
+            ParticleBurst fountain;
+            fountain.origin   = SDL_FPoint{ camera.View().x + SDL_randf() * kViewW,
+                                            camera.View().y + kViewH };
+            fountain.count    = benchParticles - (int)particles.Count();
+            fountain.spread   = 60.f;
+            fountain.speedMin = 300.f;
+            fountain.speedMax = 700.f;
+            fountain.lifeMin  = 1.f;
+            fountain.lifeMax  = 2.f;
+            fountain.color    = SDL_FColor{ 0.6f, 0.8f, 1.f, 1.f };
+            particles.Emit(fountain);
+        }
+        particles.Update(frameDt, 0.f, kGravity * 0.5f * currState.gravityDir);
+
+        BuildWorldDrawList(level, camera, view, assets, benchSprites,
+                           (float)((double)nowNS / SDL_NS_PER_SECOND), worldList);
+        particles.Draw(camera, worldList);
+        worldList.Sort();
+        if (captureAll || screenshotPending) {
+            backend->CaptureFrame(capture);
+            screenshotPending = false;
         }
+        backend->DrawStatic(staticList, staticVersion);
+        backend->DrawDynamic(worldList);
 
-        // Walls
-        if (texWall) {
-            for (const auto& w : walls) {
-                SDL_RenderTexture(ren, texWall, nullptr, &w);
-            }
-        } else {
-            SDL_SetRenderDrawColor(ren, 120, 120, 120, SDL_ALPHA_OPAQUE);
-            for (const auto& w : walls) {
-                SDL_RenderFillRect(ren, &w);
-            }
+        // Time blocked on vsync in Present is waiting, not work
+        Uint64 workNS = SDL_GetTicksNS() - frameStartNS;
+        backend->Present();
+        if (pacer.Mode() != PacingMode::VSync) workNS = SDL_GetTicksNS() - frameStartNS;
+
+        Uint64 missedBefore = pacer.Stats().missedDeadlines;
+        pacer.EndFrame();
+
+        if (resolution.Enabled()) {
+            bool missed = pacer.Stats().missedDeadlines != missedBefore;
+            backend->SetResolutionScale(resolution.Update(workNS, missed));
         }
 
-        // Player (rotated)
-        if (texPlayer) {
-            SDL_FPoint center{ player.w / 2.0f, player.h / 2.0f }; // rotate around center
-            SDL_RenderTextureRotated(
-                ren,
-                texPlayer,
-                nullptr,      // full source texture
-                &player,      // destination rect
-                playerAngle,  // angle in degrees
-                &center,
-                SDL_FLIP_NONE // no extra flip
-            );
-        } else {
-            // Fallback: no rotation for solid rect, just draw
-            SDL_SetRenderDrawColor(ren, 0, 200, 0, SDL_ALPHA_OPAQUE);
-            SDL_RenderFillRect(ren, &player);
+        statsLog.Add(backend->FrameStats(), workNS); // no-op without --stats-csv
+        if (showStats) { // shown over the next frame
+            std::vector<std::string> overlay =
+                FormatRenderStats(backend->FrameStats(), RenderBackendName(backend->Kind()),
+                                  (double)workNS / 1e6, resolution.Scale());
+            overlay.push_back(textures.Summary());
+            backend->SetOverlay(overlay);
         }
+    }
 
-        SDL_RenderPresent(ren);
+    pacer.Report();
+    resolution.Report();
+    particles.Report();
+    statsLog.Close();
+    level.Report();
+    loader.Report();
+    textures.Report();
+
+    if (recording) recorder.Save(recordPath, currState);
+    if (replayDone && replay.Checksum() != 0) {
+        bool match = replay.Checksum() == PlayerChecksum(currState);
+        std::cout << "Replay final state " << (match ? "matches" : "DIVERGED from")
+                  << " the recording.\n";
     }
 
     // Cleanup
-    if (texPlayer) SDL_DestroyTexture(texPlayer);
-    if (texWall)   SDL_DestroyTexture(texWall);
-    if (texBg)     SDL_DestroyTexture(texBg);
+    atlas.Destroy(*backend);
+    for (AssetId id : layerAssets) textures.Release(id);
+    textures.Clear();
+    backend->Shutdown(); // flushes frames still being read back
+    capture.Stop();
+    capture.Report();
 
-    SDL_DestroyRenderer(ren);
     SDL_DestroyWindow(window);
     SDL_Quit();
 
-    std::cout << "SDL3 FlipMan + BMP assets + rotation: exit\n";
+    std::cout << "SDL3 FlipMan + PNG assets + rotation: exit\n";
     return 0;
 }
@@ -0,0 +1,66 @@
+// src/null_backend.cpp - Render backend that does all the CPU work and draws nothing
+#include "null_backend.h"
+
+#include <iostream>
+
+bool NullBackend::Init(SDL_Window*, bool)
+{
+    std::cout << "Null render backend: frames are built and dropped.\n";
+    return true;
+}
+
+void NullBackend::Shutdown()
+{
+    if (frames_ > 0) {
+        std::cout << "Null render backend: " << frames_ << " frames, avg "
+                  << (double)vertices_ / frames_ << " vertices and "
+                  << (double)batches_ / frames_ << " batches per frame\n";
+    }
+}
+
+TextureId NullBackend::CreateTexture(SDL_Surface* surf)
+{
+    if (!surf) return kNoTexture;
+    frameStats_.bytesUploaded += (Uint64)surf->pitch * (Uint64)surf->h;
+    return nextTexture_++;
+}
+
+void NullBackend::CountGeometry(const GeometryList& geometry)
+{
+    for (const GeometryBatch& b : geometry.batches) {
+        frameStats_.drawCalls     += 1;
+        frameStats_.vertices      += (Uint32)b.indexCount;
+        frameStats_.bytesUploaded += (Uint64)b.indexCount * sizeof(SDL_Vertex);
+        if (b.texture != kNoTexture && b.texture != boundTexture_) {
+            frameStats_.textureBinds += 1;
+            boundTexture_ = b.texture;
+        }
+    }
+}
+
+void NullBackend::DrawStatic(const DrawList& list, Uint64 version)
+{
+    if (!haveStatic_ || version != staticVersion_) {
+        staticGeometry_.Build(list);
+        staticVersion_ = version;
+        haveStatic_    = true;
+    }
+    vertices_ += staticGeometry_.vertices.size();
+    batches_  += staticGeometry_.batches.size();
+    boundTexture_ = kNoTexture;
+    CountGeometry(staticGeometry_);
+}
+
+void NullBackend::DrawDynamic(const DrawList& list)
+{
+    dynamicGeometry_.Build(list);
+    vertices_ += dynamicGeometry_.vertices.size();
+    batches_  += dynamicGeometry_.batches.size();
+    CountGeometry(dynamicGeometry_);
+}
+
+void NullBackend::Present()
+{
+    ++frames_;
+    FinishFrameStats();
+}
@@ -0,0 +1,42 @@
+// src/null_backend.h - Render backend that does all the CPU work and draws nothing
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include "render_backend.h"
+
+// Batches every draw list into geometry exactly like the SDL_Renderer
+// backend, then throws it away. Frame times under this backend are the
+// CPU cost of scene traversal and batching, without driver or GPU time.
+class NullBackend : public RenderBackend
+{
+public:
+    RenderBackendKind Kind() const override { return RenderBackendKind::Null; }
+
+    bool Init(SDL_Window* window, bool vsync) override;
+    void Shutdown() override;
+    bool VSyncActive() const override { return false; }
+
+    // Hands out ids without uploading anything
+    TextureId CreateTexture(SDL_Surface* surf) override;
+    void      DestroyTexture(TextureId) override {}
+
+    void DrawStatic(const DrawList& list, Uint64 version) override;
+    void DrawDynamic(const DrawList& list) override;
+    void Present() override;
+
+private:
+    // Count `geometry` as if it were submitted one batch per draw call
+    void CountGeometry(const GeometryList& geometry);
+
+    GeometryList staticGeometry_;
+    Uint64       staticVersion_ = 0;
+    bool         haveStatic_    = false;
+    GeometryList dynamicGeometry_;
+    TextureId    nextTexture_   = 1;
+    TextureId    boundTexture_  = kNoTexture;
+
+    Uint64 frames_   = 0;
+    Uint64 vertices_ = 0; // built over all frames, static + dynamic
+    Uint64 batches_  = 0;
+};
@@ -0,0 +1,209 @@
+// src/particles.cpp - Effect particles: SoA storage, SIMD update, one draw batch
+#include "particles.h"
+
+#include <SDL3/SDL_intrin.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "camera.h"
+#include "scene.h"
+
+static constexpr float kParticleSize = 4.f; // world units, square
+
+// ----------------------------------------------------------------------
+// Update kernels: v += g * dt, p += v * dt, life -= dt over [begin, end)
+// ----------------------------------------------------------------------
+static void IntegrateScalar(float* x, float* y, float* vx, float* vy, float* life,
+                            size_t begin, size_t end, float dt, float gx, float gy)
+{
+    const float dvx = gx * dt;
+    const float dvy = gy * dt;
+    for (size_t i = begin; i < end; ++i) {
+        vx[i]   += dvx;
+        vy[i]   += dvy;
+        x[i]    += vx[i] * dt;
+        y[i]    += vy[i] * dt;
+        life[i] -= dt;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+SDL_TARGETING("sse2")
+static void IntegrateSse2(float* x, float* y, float* vx, float* vy, float* life,
+                          size_t count, float dt, float gx, float gy)
+{
+    const __m128 vdt  = _mm_set1_ps(dt);
+    const __m128 vdvx = _mm_set1_ps(gx * dt);
+    const __m128 vdvy = _mm_set1_ps(gy * dt);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 nvx = _mm_add_ps(_mm_loadu_ps(vx + i), vdvx);
+        __m128 nvy = _mm_add_ps(_mm_loadu_ps(vy + i), vdvy);
+        _mm_storeu_ps(vx + i, nvx);
+        _mm_storeu_ps(vy + i, nvy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(nvx, vdt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(nvy, vdt)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), vdt));
+    }
+    IntegrateScalar(x, y, vx, vy, life, i, count, dt, gx, gy);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_TARGETING("avx2")
+static void IntegrateAvx2(float* x, float* y, float* vx, float* vy, float* life,
+                          size_t count, float dt, float gx, float gy)
+{
+    const __m256 vdt  = _mm256_set1_ps(dt);
+    const __m256 vdvx = _mm256_set1_ps(gx * dt);
+    const __m256 vdvy = _mm256_set1_ps(gy * dt);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 nvx = _mm256_add_ps(_mm256_loadu_ps(vx + i), vdvx);
+        __m256 nvy = _mm256_add_ps(_mm256_loadu_ps(vy + i), vdvy);
+        _mm256_storeu_ps(vx + i, nvx);
+        _mm256_storeu_ps(vy + i, nvy);
+        _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(nvx, vdt)));
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(nvy, vdt)));
+        _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), vdt));
+    }
+    IntegrateScalar(x, y, vx, vy, life, i, count, dt, gx, gy);
+}
+#endif
+
+// ----------------------------------------------------------------------
+// ParticleSystem
+// ----------------------------------------------------------------------
+ParticleSystem::ParticleSystem(size_t capacity)
+    : capacity_(capacity), kernel_(Kernel::Scalar), rng_(SDL_GetPerformanceCounter())
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) kernel_ = Kernel::Avx2;
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (kernel_ == Kernel::Scalar && SDL_HasSSE2()) kernel_ = Kernel::Sse2;
+#endif
+
+    x_.resize(capacity_);
+    y_.resize(capacity_);
+    vx_.resize(capacity_);
+    vy_.resize(capacity_);
+    life_.resize(capacity_);
+    invLife_.resize(capacity_);
+    color_.resize(capacity_);
+}
+
+const char* ParticleSystem::KernelName() const
+{
+    switch (kernel_) {
+    case Kernel::Avx2: return "avx2";
+    case Kernel::Sse2: return "sse2";
+    case Kernel::Scalar: break;
+    }
+    return "scalar";
+}
+
+void ParticleSystem::Emit(const ParticleBurst& burst)
+{
+    const size_t n = std::min((size_t)std::max(burst.count, 0), capacity_ - count_);
+    for (size_t k = 0; k < n; ++k) {
+        const float rad   = (burst.angle + (SDL_randf_r(&rng_) - 0.5f) * burst.spread)
+                          * (SDL_PI_F / 180.f);
+        const float speed = burst.speedMin + SDL_randf_r(&rng_) * (burst.speedMax - burst.speedMin);
+        const float life  = burst.lifeMin + SDL_randf_r(&rng_) * (burst.lifeMax - burst.lifeMin);
+
+        const size_t i = count_++;
+        x_[i]       = burst.origin.x;
+        y_[i]       = burst.origin.y;
+        vx_[i]      = std::cos(rad) * speed;
+        vy_[i]      = std::sin(rad) * speed;
+        life_[i]    = life;
+        invLife_[i] = life > 0.f ? 1.f / life : 0.f;
+        color_[i]   = burst.color;
+    }
+    peakCount_ = std::max(peakCount_, count_);
+}
+
+void ParticleSystem::Update(float dt, float gx, float gy)
+{
+    const Uint64 startNS = SDL_GetTicksNS();
+
+    switch (kernel_) {
+#ifdef SDL_AVX2_INTRINSICS
+    case Kernel::Avx2:
+        IntegrateAvx2(x_.data(), y_.data(), vx_.data(), vy_.data(), life_.data(),
+                      count_, dt, gx, gy);
+        break;
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    case Kernel::Sse2:
+        IntegrateSse2(x_.data(), y_.data(), vx_.data(), vy_.data(), life_.data(),
+                      count_, dt, gx, gy);
+        break;
+#endif
+    default:
+        IntegrateScalar(x_.data(), y_.data(), vx_.data(), vy_.data(), life_.data(),
+                        0, count_, dt, gx, gy);
+        break;
+    }
+
+    // Drop expired particles by moving the last live one into the hole.
+    // Order doesn't matter, and only the life array is scanned.
+    size_t i = 0;
+    while (i < count_) {
+        if (life_[i] > 0.f) {
+            ++i;
+            continue;
+        }
+        const size_t last = --count_;
+        x_[i]       = x_[last];
+        y_[i]       = y_[last];
+        vx_[i]      = vx_[last];
+        vy_[i]      = vy_[last];
+        life_[i]    = life_[last];
+        invLife_[i] = invLife_[last];
+        color_[i]   = color_[last];
+    }
+
+    const Uint64 ns = SDL_GetTicksNS() - startNS;
+    updateNS_ += ns;
+    worstNS_   = std::max(worstNS_, ns);
+    ++updates_;
+}
+
+void ParticleSystem::Draw(const Camera& camera, DrawList& out) const
+{
+    const SDL_FRect& view = camera.View();
+    const float half = kParticleSize * 0.5f;
+    const float minX = view.x - half, maxX = view.x + view.w + half;
+    const float minY = view.y - half, maxY = view.y + view.h + half;
+
+    DrawCmd cmd; // untextured, so consecutive quads share one batch
+    cmd.layer = kLayerEffects;
+    cmd.dst.w = kParticleSize;
+    cmd.dst.h = kParticleSize;
+    for (size_t i = 0; i < count_; ++i) {
+        const float px = x_[i];
+        const float py = y_[i];
+        if (px < minX || px > maxX || py < minY || py > maxY) continue;
+
+        cmd.dst.x   = px - half - view.x;
+        cmd.dst.y   = py - half - view.y;
+        cmd.color   = color_[i];
+        cmd.color.a *= std::min(life_[i] * invLife_[i], 1.f);
+        out.Push(cmd);
+    }
+}
+
+void ParticleSystem::Report() const
+{
+    if (updates_ == 0) return;
+
+    std::cout << "Particles: " << KernelName() << " kernel, peak " << peakCount_
+              << " of " << capacity_ << ", update avg "
+              << (double)updateNS_ / (double)updates_ / 1000.0 << " us, worst "
+              << (double)worstNS_ / 1000.0 << " us\n";
+}
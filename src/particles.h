@@ -0,0 +1,79 @@
+// src/particles.h - Effect particles: SoA storage, SIMD update, one draw batch
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+#include "render_backend.h"
+
+class Camera;
+
+// One burst of particles fired from a point in world space
+struct ParticleBurst
+{
+    SDL_FPoint origin{};
+    int        count     = 24;
+    float      angle     = -90.f;  // centre direction in degrees (0 = +x, 90 = down)
+    float      spread    = 360.f;  // cone width in degrees
+    float      speedMin  = 40.f;   // world units per second
+    float      speedMax  = 160.f;
+    float      lifeMin   = 0.3f;   // seconds
+    float      lifeMax   = 0.8f;
+    SDL_FColor color{ 1.f, 1.f, 1.f, 1.f };
+};
+
+// Short-lived cosmetic particles (flip bursts, landing dust, trails).
+// Nothing here feeds back into the simulation, so it runs per rendered
+// frame on wall-clock time and may use its own random numbers.
+//
+// Positions, velocities and lifetimes live in separate arrays so the
+// update is a straight SIMD loop: AVX2 or SSE2, whichever the CPU has
+// (checked once at startup), with a scalar tail and fallback. Every live
+// particle is drawn as an untextured quad on kLayerEffects, so a sorted
+// list puts them all in one geometry batch - one SDL_RenderGeometry call.
+class ParticleSystem
+{
+public:
+    explicit ParticleSystem(size_t capacity = 100000);
+
+    // Spawn a burst. Particles beyond capacity are dropped.
+    void Emit(const ParticleBurst& burst);
+
+    // Advance every particle by dt seconds under gravity (gx, gy) and
+    // drop the expired ones.
+    void Update(float dt, float gx, float gy);
+
+    // Append one quad per live particle inside the camera view, fading
+    // out over its lifetime.
+    void Draw(const Camera& camera, DrawList& out) const;
+
+    size_t Count() const    { return count_; }
+    size_t Capacity() const { return capacity_; }
+
+    // "avx2", "sse2" or "scalar"
+    const char* KernelName() const;
+
+    // Print a one-line summary (kernel, peak count, update cost) to stdout.
+    void Report() const;
+
+private:
+    enum class Kernel { Scalar, Sse2, Avx2 };
+
+    size_t capacity_;
+    size_t count_ = 0;
+    Kernel kernel_;
+    Uint64 rng_;
+
+    // Structure of arrays, [0, count_) live
+    std::vector<float>  x_, y_;
+    std::vector<float>  vx_, vy_;
+    std::vector<float>  life_;     // seconds left
+    std::vector<float>  invLife_;  // 1 / initial life, for the fade
+    std::vector<SDL_FColor> color_;
+
+    // Stats
+    size_t peakCount_   = 0;
+    Uint64 updates_     = 0;
+    Uint64 updateNS_    = 0; // total time in Update()
+    Uint64 worstNS_     = 0;
+};
@@ -0,0 +1,668 @@
+// src/png_decoder.cpp - PNG decoding without external libraries: inflate + unfiltering
+#include "png_decoder.h"
+
+#include <SDL3/SDL_endian.h>
+#include <SDL3/SDL_intrin.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const Uint8 kPngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+static Uint32 BigEndian32(const Uint8* p)
+{
+    return (Uint32)p[0] << 24 | (Uint32)p[1] << 16 | (Uint32)p[2] << 8 | (Uint32)p[3];
+}
+
+// ----------------------------------------------------------------------
+// Inflate (RFC 1950/1951)
+// ----------------------------------------------------------------------
+
+// Reads the deflate bit stream LSB first, 64 bits at a time
+class BitReader
+{
+public:
+    BitReader(const Uint8* data, size_t size) : p_(data), end_(data + size) {}
+
+    // Afterwards at least 56 bits are buffered; past the end they read
+    // as zeros, which Overrun() reports.
+    void Refill()
+    {
+        if (end_ - p_ >= 8) {
+            Uint64 word;
+            std::memcpy(&word, p_, 8);
+            bits_ |= SDL_Swap64LE(word) << count_;
+            p_ += (63 - count_) >> 3;
+            count_ |= 56;
+            return;
+        }
+        while (count_ <= 56) {
+            if (p_ < end_) bits_ |= (Uint64)*p_++ << count_;
+            else           ++overrun_;
+            count_ += 8;
+        }
+    }
+
+    Uint32 Peek(int n) const { return (Uint32)(bits_ & ((1ull << n) - 1)); }
+    void   Drop(int n)       { bits_ >>= n; count_ -= n; }
+
+    Uint32 Get(int n)
+    {
+        Uint32 v = Peek(n);
+        Drop(n);
+        return v;
+    }
+
+    // Skip to the next byte boundary and give back the whole bytes still
+    // buffered, so stored blocks can be copied straight from the input.
+    const Uint8* AlignToByte()
+    {
+        Drop(count_ & 7);
+        const int buffered = count_ >> 3;
+        const int padding  = SDL_min(overrun_, buffered); // never came from p_
+        p_ -= buffered - padding;
+        overrun_ -= padding;
+        bits_  = 0;
+        count_ = 0;
+        return p_;
+    }
+
+    void Skip(size_t bytes) { p_ += bytes; }
+    size_t Left() const     { return (size_t)(end_ - p_); }
+    bool Overrun() const    { return overrun_ > count_ / 8; }
+
+private:
+    const Uint8* p_;
+    const Uint8* end_;
+    Uint64       bits_    = 0;
+    int          count_   = 0;
+    int          overrun_ = 0; // zero bytes fed in past the end
+};
+
+// Canonical Huffman code. Codes up to kFastBits long decode with one table
+// lookup; longer ones (rare in practice) walk the canonical code.
+class Huffman
+{
+public:
+    static constexpr int kMaxBits  = 15;
+    static constexpr int kFastBits = 10;
+
+    bool Build(const Uint8* lengths, int count)
+    {
+        std::memset(counts_, 0, sizeof(counts_));
+        std::memset(fast_, 0, sizeof(fast_));
+        for (int i = 0; i < count; ++i) ++counts_[lengths[i]];
+        counts_[0] = 0;
+
+        // Over-subscribed sets are corrupt; incomplete ones are allowed
+        // (a distance code may have a single symbol)
+        int left = 1;
+        for (int len = 1; len <= kMaxBits; ++len) {
+            left = (left << 1) - counts_[len];
+            if (left < 0) return false;
+        }
+
+        Uint16 offsets[kMaxBits + 2];
+        offsets[1] = 0;
+        for (int len = 1; len <= kMaxBits; ++len) offsets[len + 1] = offsets[len] + counts_[len];
+        for (int i = 0; i < count; ++i) {
+            if (lengths[i]) symbols_[offsets[lengths[i]]++] = (Uint16)i;
+        }
+
+        // Fast table, indexed by the next kFastBits input bits (which hold
+        // the code reversed, as deflate sends it MSB first)
+        int code = 0;
+        int next = 0;
+        for (int len = 1; len <= kFastBits; ++len) {
+            for (int k = 0; k < counts_[len]; ++k, ++code) {
+                int rev = 0;
+                for (int b = 0; b < len; ++b) rev |= ((code >> b) & 1) << (len - 1 - b);
+                const Uint16 entry = (Uint16)(symbols_[next++] | len << 9);
+                for (int j = rev; j < (1 << kFastBits); j += 1 << len) fast_[j] = entry;
+            }
+            code <<= 1;
+        }
+        return true;
+    }
+
+    // Next symbol, or -1 for a code that isn't in the table. Needs
+    // kMaxBits bits buffered.
+    int Decode(BitReader& in) const
+    {
+        const Uint16 entry = fast_[in.Peek(kFastBits)];
+        if (entry) {
+            in.Drop(entry >> 9);
+            return entry & 0x1FF;
+        }
+
+        // Walk the canonical code one bit at a time (puff's approach)
+        int code = 0, first = 0, index = 0;
+        for (int len = 1; len <= kMaxBits; ++len) {
+            code |= (int)in.Get(1);
+            const int count = counts_[len];
+            if (code - first < count) return symbols_[index + code - first];
+            index += count;
+            first  = (first + count) << 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+private:
+    Uint16 counts_[kMaxBits + 1];
+    Uint16 symbols_[288];
+    Uint16 fast_[1 << kFastBits]; // symbol | length << 9, 0 = longer code
+};
+
+static const Uint16 kLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const Uint8  kLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                         3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const Uint16 kDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                      257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                      8193, 12289, 16385, 24577 };
+static const Uint8  kDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                       7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// Decode the symbols of one Huffman block into out[pos, size)
+static bool InflateBlock(BitReader& in, const Huffman& lit, const Huffman& dist,
+                         Uint8* out, size_t& pos, size_t size)
+{
+    for (;;) {
+        in.Refill(); // enough for a length and a distance with their extra bits
+        int sym = lit.Decode(in);
+        if (sym < 256) {
+            if (sym < 0 || pos >= size) return false;
+            out[pos++] = (Uint8)sym;
+            continue;
+        }
+        if (sym == 256) return true;
+
+        sym -= 257;
+        if (sym >= 29) return false;
+        const size_t len = kLengthBase[sym] + in.Get(kLengthExtra[sym]);
+        const int dsym = dist.Decode(in);
+        if (dsym < 0 || dsym >= 30) return false;
+        const size_t d = kDistBase[dsym] + in.Get(kDistExtra[dsym]);
+        if (d > pos || len > size - pos) return false;
+
+        Uint8*       dst = out + pos;
+        const Uint8* src = dst - d;
+        pos += len;
+        if (d >= 8) {
+            // Non-overlapping 8-byte steps; may copy a few bytes past
+            // `len` that the next symbols overwrite
+            Uint8* const end = dst + len;
+            if (out + size - end >= 8) {
+                do {
+                    std::memcpy(dst, src, 8);
+                    dst += 8;
+                    src += 8;
+                } while (dst < end);
+                continue;
+            }
+        }
+        for (size_t i = 0; i < len; ++i) dst[i] = src[i];
+    }
+}
+
+static bool Inflate(const Uint8* data, size_t size, Uint8* out, size_t outSize,
+                    std::string& error)
+{
+    if (size < 2 || (data[0] & 0x0F) != 8 || (data[0] >> 4) > 7 ||
+        ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20)) {
+        error = "bad zlib header";
+        return false;
+    }
+
+    BitReader in(data + 2, size - 2);
+    Huffman   lit, dist;
+    size_t    pos = 0;
+    bool      last = false;
+    while (!last) {
+        in.Refill();
+        last = in.Get(1) != 0;
+        const Uint32 type = in.Get(2);
+
+        if (type == 0) {
+            const Uint8* p = in.AlignToByte();
+            if (in.Left() < 4) break;
+            const Uint32 len  = p[0] | p[1] << 8;
+            const Uint32 nlen = p[2] | p[3] << 8;
+            if ((len ^ 0xFFFF) != nlen || in.Left() - 4 < len || outSize - pos < len) break;
+            std::memcpy(out + pos, p + 4, len);
+            pos += len;
+            in.Skip(4 + (size_t)len);
+            continue;
+        }
+
+        if (type == 1) {
+            Uint8 lengths[288 + 30];
+            std::memset(lengths, 8, 144);
+            std::memset(lengths + 144, 9, 112);
+            std::memset(lengths + 256, 7, 24);
+            std::memset(lengths + 280, 8, 8);
+            std::memset(lengths + 288, 5, 30);
+            lit.Build(lengths, 288);
+            dist.Build(lengths + 288, 30);
+        } else if (type == 2) {
+            const int nlit  = (int)in.Get(5) + 257;
+            const int ndist = (int)in.Get(5) + 1;
+            const int nclen = (int)in.Get(4) + 4;
+            static const Uint8 kOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5,
+                                              11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            Uint8 clens[19] = {};
+            for (int i = 0; i < nclen; ++i) {
+                in.Refill();
+                clens[kOrder[i]] = (Uint8)in.Get(3);
+            }
+            Huffman clen;
+            if (nlit > 286 || ndist > 30 || !clen.Build(clens, 19)) break;
+
+            Uint8 lengths[288 + 30] = {};
+            int n = 0;
+            while (n < nlit + ndist) {
+                in.Refill();
+                const int sym = clen.Decode(in);
+                if (sym < 0) break;
+                if (sym < 16) {
+                    lengths[n++] = (Uint8)sym;
+                    continue;
+                }
+                Uint8 value = 0;
+                int   repeat;
+                if (sym == 16) {
+                    if (n == 0) break;
+                    value  = lengths[n - 1];
+                    repeat = 3 + (int)in.Get(2);
+                } else if (sym == 17) {
+                    repeat = 3 + (int)in.Get(3);
+                } else {
+                    repeat = 11 + (int)in.Get(7);
+                }
+                if (n + repeat > nlit + ndist) break;
+                while (repeat--) lengths[n++] = value;
+            }
+            if (n != nlit + ndist || lengths[256] == 0) break;
+            // The distance lengths follow the literal ones directly
+            Uint8 distLengths[30];
+            std::memcpy(distLengths, lengths + nlit, (size_t)ndist);
+            if (!lit.Build(lengths, nlit) || !dist.Build(distLengths, ndist)) break;
+        } else {
+            break;
+        }
+
+        if (!InflateBlock(in, lit, dist, out, pos, outSize)) break;
+        if (in.Overrun()) break;
+    }
+
+    if (!last || in.Overrun()) {
+        error = "corrupt image data";
+        return false;
+    }
+    if (pos != outSize) {
+        error = "image data too short";
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Unfiltering: each row is prefixed by its filter type and predicted
+// from the pixel to the left (a), above (b) and above-left (c)
+// ----------------------------------------------------------------------
+
+static Uint8 Paeth(int a, int b, int c)
+{
+    const int pa = std::abs(b - c);
+    const int pb = std::abs(a - c);
+    const int pc = std::abs(a + b - 2 * c);
+    if (pa <= pb && pa <= pc) return (Uint8)a;
+    return (Uint8)(pb <= pc ? b : c);
+}
+
+static void UnfilterScalar(Uint8 filter, Uint8* row, const Uint8* prev, size_t n, size_t bpp)
+{
+    switch (filter) {
+    case 1:
+        for (size_t i = bpp; i < n; ++i) row[i] += row[i - bpp];
+        break;
+    case 2:
+        for (size_t i = 0; i < n; ++i) row[i] += prev[i];
+        break;
+    case 3:
+        for (size_t i = 0; i < bpp; ++i) row[i] += prev[i] >> 1;
+        for (size_t i = bpp; i < n; ++i) row[i] += (Uint8)((row[i - bpp] + prev[i]) >> 1);
+        break;
+    case 4:
+        for (size_t i = 0; i < bpp; ++i) row[i] += prev[i]; // Paeth(0, b, 0) == b
+        for (size_t i = bpp; i < n; ++i) row[i] += Paeth(row[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// One pixel of 3 or 4 bytes in the low lanes of an XMM register
+static __m128i LoadPixel(const Uint8* p, size_t bpp)
+{
+    Uint32 v = 0;
+    std::memcpy(&v, p, bpp);
+    return _mm_cvtsi32_si128((int)v);
+}
+
+static void StorePixel(Uint8* p, __m128i v, size_t bpp)
+{
+    const Uint32 w = (Uint32)_mm_cvtsi128_si32(v);
+    std::memcpy(p, &w, bpp);
+}
+
+// Rows of 3- or 4-byte pixels. Sub, Average and Paeth depend on the
+// pixel just decoded, so they go a pixel at a time with its channels in
+// parallel; Up has no such chain and goes 16 bytes at a time.
+static void UnfilterSSE2(Uint8 filter, Uint8* row, const Uint8* prev, size_t n, size_t bpp)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = zero; // left
+    __m128i c = zero; // above-left
+
+    switch (filter) {
+    case 1:
+        for (size_t i = 0; i < n; i += bpp) {
+            a = _mm_add_epi8(a, LoadPixel(row + i, bpp));
+            StorePixel(row + i, a, bpp);
+        }
+        break;
+    case 2: {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i x = _mm_loadu_si128((const __m128i*)(row + i));
+            const __m128i b = _mm_loadu_si128((const __m128i*)(prev + i));
+            _mm_storeu_si128((__m128i*)(row + i), _mm_add_epi8(x, b));
+        }
+        for (; i < n; ++i) row[i] += prev[i];
+        break;
+    }
+    case 3: {
+        const __m128i one = _mm_set1_epi8(1);
+        for (size_t i = 0; i < n; i += bpp) {
+            const __m128i b = LoadPixel(prev + i, bpp);
+            // floor((a + b) / 2): pavgb rounds up, so take back the odd bit
+            const __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b),
+                                             _mm_and_si128(_mm_xor_si128(a, b), one));
+            a = _mm_add_epi8(LoadPixel(row + i, bpp), avg);
+            StorePixel(row + i, a, bpp);
+        }
+        break;
+    }
+    case 4:
+        for (size_t i = 0; i < n; i += bpp) {
+            const __m128i b = _mm_unpacklo_epi8(LoadPixel(prev + i, bpp), zero);
+            const __m128i a16 = _mm_unpacklo_epi8(a, zero);
+            const __m128i c16 = _mm_unpacklo_epi8(c, zero);
+
+            // |b - c|, |a - c| and |a + b - 2c| in 16-bit lanes
+            const __m128i bMinusC = _mm_sub_epi16(b, c16);
+            const __m128i aMinusC = _mm_sub_epi16(a16, c16);
+            const __m128i sum     = _mm_add_epi16(bMinusC, aMinusC);
+            const __m128i pa = _mm_max_epi16(bMinusC, _mm_sub_epi16(zero, bMinusC));
+            const __m128i pb = _mm_max_epi16(aMinusC, _mm_sub_epi16(zero, aMinusC));
+            const __m128i pc = _mm_max_epi16(sum, _mm_sub_epi16(zero, sum));
+
+            // a if pa <= pb and pa <= pc, else b if pb <= pc, else c
+            const __m128i useA = _mm_andnot_si128(_mm_or_si128(_mm_cmpgt_epi16(pa, pb),
+                                                                _mm_cmpgt_epi16(pa, pc)),
+                                                  _mm_set1_epi16(-1));
+            const __m128i useB = _mm_andnot_si128(_mm_cmpgt_epi16(pb, pc), _mm_set1_epi16(-1));
+            const __m128i bc   = _mm_or_si128(_mm_and_si128(useB, b), _mm_andnot_si128(useB, c16));
+            const __m128i pred = _mm_or_si128(_mm_and_si128(useA, a16), _mm_andnot_si128(useA, bc));
+
+            c = _mm_packus_epi16(b, zero);
+            a = _mm_add_epi8(LoadPixel(row + i, bpp), _mm_packus_epi16(pred, zero));
+            StorePixel(row + i, a, bpp);
+        }
+        break;
+    default:
+        break;
+    }
+}
+#endif
+
+static bool Unfilter(Uint8* data, Uint32 height, size_t rowBytes, size_t bpp, std::string& error)
+{
+    std::vector<Uint8> zeros(rowBytes, 0);
+    const Uint8* prev = zeros.data();
+    for (Uint32 y = 0; y < height; ++y) {
+        Uint8* line = data + (size_t)y * (rowBytes + 1);
+        const Uint8 filter = line[0];
+        if (filter > 4) {
+            error = "bad filter type";
+            return false;
+        }
+#ifdef SDL_SSE2_INTRINSICS
+        if (bpp == 3 || bpp == 4) UnfilterSSE2(filter, line + 1, prev, rowBytes, bpp);
+        else
+#endif
+        UnfilterScalar(filter, line + 1, prev, rowBytes, bpp);
+        prev = line + 1;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// Pixel conversion to RGBA8
+// ----------------------------------------------------------------------
+
+struct Palette
+{
+    Uint8 rgba[256][4] = {}; // indices past the palette read as transparent black
+    int   count = 0;
+};
+
+static int Channels(Uint8 colorType)
+{
+    switch (colorType) {
+    case 0: return 1;
+    case 2: return 3;
+    case 3: return 1;
+    case 4: return 2;
+    case 6: return 4;
+    default: return 0;
+    }
+}
+
+// One unfiltered row to RGBA. `key` is the tRNS colour for types 0 and 2
+// (-1 components when there is none).
+static void ConvertRow(const PngInfo& info, const Uint8* src, Uint8* dst,
+                       const Palette& palette, const int key[3])
+{
+    const Uint32 w = info.width;
+    const int    depth = info.bitDepth;
+
+    if (depth < 8) {
+        // Gray or palette indices packed MSB first
+        const int mask  = (1 << depth) - 1;
+        const int scale = info.colorType == 0 ? 255 / mask : 1;
+        for (Uint32 x = 0; x < w; ++x) {
+            const size_t bit = (size_t)x * depth;
+            const int v = (src[bit >> 3] >> (8 - depth - (int)(bit & 7))) & mask;
+            Uint8* o = dst + (size_t)x * 4;
+            if (info.colorType == 3) {
+                std::memcpy(o, palette.rgba[v], 4);
+            } else {
+                o[0] = o[1] = o[2] = (Uint8)(v * scale);
+                o[3] = v == key[0] ? 0 : 255;
+            }
+        }
+        return;
+    }
+
+    // 8- or 16-bit samples: keep the high byte, compare full values to the key
+    const int step = depth / 8;
+    auto sample = [&](Uint32 x, int channel, int channels) {
+        const Uint8* s = src + ((size_t)x * channels + channel) * step;
+        return step == 1 ? (int)s[0] : (int)(s[0] << 8 | s[1]);
+    };
+    for (Uint32 x = 0; x < w; ++x) {
+        Uint8* o = dst + (size_t)x * 4;
+        switch (info.colorType) {
+        case 0: {
+            const int g = sample(x, 0, 1);
+            o[0] = o[1] = o[2] = (Uint8)(step == 1 ? g : g >> 8);
+            o[3] = g == key[0] ? 0 : 255;
+            break;
+        }
+        case 2: {
+            const int r = sample(x, 0, 3), g = sample(x, 1, 3), b = sample(x, 2, 3);
+            const int shift = step == 1 ? 0 : 8;
+            o[0] = (Uint8)(r >> shift);
+            o[1] = (Uint8)(g >> shift);
+            o[2] = (Uint8)(b >> shift);
+            o[3] = (r == key[0] && g == key[1] && b == key[2]) ? 0 : 255;
+            break;
+        }
+        case 3:
+            std::memcpy(o, palette.rgba[src[x]], 4);
+            break;
+        case 4:
+            o[0] = o[1] = o[2] = src[(size_t)x * 2 * step];
+            o[3] = src[((size_t)x * 2 + 1) * step];
+            break;
+        case 6:
+            for (int ch = 0; ch < 4; ++ch) o[ch] = src[((size_t)x * 4 + ch) * step];
+            break;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------
+// PNG
+// ----------------------------------------------------------------------
+
+bool IsPng(const void* data, size_t size)
+{
+    return size >= 8 && std::memcmp(data, kPngSignature, 8) == 0;
+}
+
+bool ReadPngInfo(const void* data, size_t size, PngInfo& info, std::string& error)
+{
+    const Uint8* p = (const Uint8*)data;
+    if (!IsPng(data, size)) {
+        error = "not a PNG";
+        return false;
+    }
+    if (size < 8 + 8 + 13 + 4 || std::memcmp(p + 12, "IHDR", 4) != 0 || BigEndian32(p + 8) != 13) {
+        error = "missing IHDR";
+        return false;
+    }
+
+    const Uint8* h = p + 16;
+    info.width     = BigEndian32(h);
+    info.height    = BigEndian32(h + 4);
+    info.bitDepth  = h[8];
+    info.colorType = h[9];
+    info.interlace = h[12];
+
+    const int d = info.bitDepth;
+    bool depthOk = false;
+    switch (info.colorType) {
+    case 0: depthOk = d == 1 || d == 2 || d == 4 || d == 8 || d == 16; break;
+    case 3: depthOk = d == 1 || d == 2 || d == 4 || d == 8; break;
+    case 2: case 4: case 6: depthOk = d == 8 || d == 16; break;
+    default: break;
+    }
+    if (!depthOk || h[10] != 0 || h[11] != 0) {
+        error = "unsupported colour type or bit depth";
+        return false;
+    }
+    if (info.interlace != 0) {
+        error = "interlaced PNGs aren't supported";
+        return false;
+    }
+    if (info.width == 0 || info.height == 0 || (Uint64)info.width * info.height > (1u << 28)) {
+        error = "bad image size";
+        return false;
+    }
+    return true;
+}
+
+bool DecodePng(const void* data, size_t size, Uint8* rgba, size_t pitch, std::string& error)
+{
+    PngInfo info;
+    if (!ReadPngInfo(data, size, info, error)) return false;
+
+    // Collect the chunks we need. One IDAT is inflated in place; several
+    // are joined first.
+    const Uint8* p   = (const Uint8*)data + 8;
+    const Uint8* end = (const Uint8*)data + size;
+    Palette palette;
+    int key[3] = { -1, -1, -1 };
+    const Uint8* idat = nullptr;
+    size_t idatSize = 0;
+    std::vector<Uint8> joined;
+    while (end - p >= 12) {
+        const Uint32 len = BigEndian32(p);
+        const Uint8* type = p + 4;
+        const Uint8* body = p + 8;
+        if (len > (size_t)(end - body) - 4) break;
+
+        if (std::memcmp(type, "PLTE", 4) == 0) {
+            palette.count = (int)SDL_min(len / 3, 256u);
+            for (int i = 0; i < palette.count; ++i) {
+                std::memcpy(palette.rgba[i], body + i * 3, 3);
+                palette.rgba[i][3] = 255;
+            }
+        } else if (std::memcmp(type, "tRNS", 4) == 0) {
+            if (info.colorType == 3) {
+                for (Uint32 i = 0; i < len && i < 256; ++i) palette.rgba[i][3] = body[i];
+            } else if (info.colorType == 0 && len >= 2) {
+                key[0] = body[0] << 8 | body[1];
+            } else if (info.colorType == 2 && len >= 6) {
+                for (int c = 0; c < 3; ++c) key[c] = body[c * 2] << 8 | body[c * 2 + 1];
+            }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            if (!idat) {
+                idat = body;
+                idatSize = len;
+            } else {
+                if (joined.empty()) joined.assign(idat, idat + idatSize);
+                joined.insert(joined.end(), body, body + len);
+            }
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        p = body + len + 4; // skip the CRC
+    }
+    if (!idat) {
+        error = "no image data";
+        return false;
+    }
+    if (!joined.empty()) {
+        idat = joined.data();
+        idatSize = joined.size();
+    }
+    if (info.colorType == 3 && palette.count == 0) {
+        error = "missing palette";
+        return false;
+    }
+
+    // 8-bit keys compare against 8-bit samples
+    if (info.bitDepth <= 8) {
+        for (int& k : key) if (k >= 0) k &= 0xFF;
+    }
+
+    const size_t bitsPerPixel = (size_t)info.bitDepth * Channels(info.colorType);
+    const size_t rowBytes     = ((size_t)info.width * bitsPerPixel + 7) / 8;
+    const size_t bpp          = SDL_max(bitsPerPixel / 8, (size_t)1);
+
+    std::vector<Uint8> raw((rowBytes + 1) * info.height);
+    if (!Inflate(idat, idatSize, raw.data(), raw.size(), error)) return false;
+    if (!Unfilter(raw.data(), info.height, rowBytes, bpp, error)) return false;
+
+    for (Uint32 y = 0; y < info.height; ++y) {
+        ConvertRow(info, raw.data() + (size_t)y * (rowBytes + 1) + 1, rgba + (size_t)y * pitch,
+                   palette, key);
+    }
+    return true;
+}
@@ -0,0 +1,30 @@
+// src/png_decoder.h - PNG decoding without external libraries: inflate + unfiltering
+#pragma once
+
+#include <SDL3/SDL_stdinc.h>
+#include <string>
+
+// Image size and layout from the IHDR chunk
+struct PngInfo
+{
+    Uint32 width     = 0;
+    Uint32 height    = 0;
+    Uint8  bitDepth  = 0;
+    Uint8  colorType = 0; // 0 gray, 2 RGB, 3 palette, 4 gray+alpha, 6 RGBA
+    Uint8  interlace = 0;
+};
+
+bool IsPng(const void* data, size_t size);
+
+// Parse the header. False (with `error` set) if this isn't a PNG we decode.
+bool ReadPngInfo(const void* data, size_t size, PngInfo& info, std::string& error);
+
+// Decode to 8-bit straight-alpha RGBA (bytes R, G, B, A), `pitch` bytes
+// per row into `rgba`, which must hold info.height rows.
+// Handles every non-interlaced colour type and bit depth, with tRNS
+// transparency; 16-bit channels keep their high byte. Chunk CRCs and the
+// zlib checksum aren't verified - assets come from our own pack - but the
+// stream is bounds-checked throughout, so corrupt data fails cleanly.
+// Up/Sub/Average/Paeth unfiltering uses SSE2 for 3- and 4-byte pixels.
+// Touches no global state, so decoders on several threads are fine.
+bool DecodePng(const void* data, size_t size, Uint8* rgba, size_t pitch, std::string& error);
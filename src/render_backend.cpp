@@ -0,0 +1,182 @@
+// src/render_backend.cpp - Backend-neutral draw lists and the renderer interface
+#include "render_backend.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "gpu_backend.h"
+#include "null_backend.h"
+#include "sdl_backend.h"
+
+// ----------------------------------------------------------------------
+// DrawList sorting
+// ----------------------------------------------------------------------
+Uint64 DrawSortKey(const DrawCmd& cmd)
+{
+    return ((Uint64)cmd.layer << 56) |
+           ((Uint64)cmd.depth << 40) |
+           ((Uint64)(cmd.blend & 0xFF) << 32) |
+           (Uint64)cmd.texture;
+}
+
+void DrawList::Sort()
+{
+    const size_t n = cmds.size();
+    if (n < 2) return;
+
+    // Scene traversal mostly pushes in layer order already
+    Uint64 prevKey = 0;
+    size_t i = 0;
+    for (; i < n; ++i) {
+        const Uint64 key = DrawSortKey(cmds[i]);
+        if (key < prevKey) break;
+        prevKey = key;
+    }
+    if (i == n) return;
+
+    sortEntries_.resize(n);
+    sortTemp_.resize(n);
+    Uint64 allOr  = 0;
+    Uint64 allAnd = ~(Uint64)0;
+    for (i = 0; i < n; ++i) {
+        const Uint64 key = DrawSortKey(cmds[i]);
+        sortEntries_[i] = SortEntry{ key, (Uint32)i };
+        allOr  |= key;
+        allAnd &= key;
+    }
+
+    // Bits that differ between any two keys; bytes without any are skipped
+    const Uint64 varying = allOr ^ allAnd;
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) continue;
+
+        size_t offsets[256] = {};
+        for (const SortEntry& e : sortEntries_) ++offsets[(e.key >> shift) & 0xFF];
+        size_t sum = 0;
+        for (size_t& o : offsets) {
+            size_t c = o;
+            o = sum;
+            sum += c;
+        }
+        for (const SortEntry& e : sortEntries_) sortTemp_[offsets[(e.key >> shift) & 0xFF]++] = e;
+        sortEntries_.swap(sortTemp_);
+    }
+
+    sortedCmds_.resize(n);
+    for (i = 0; i < n; ++i) sortedCmds_[i] = cmds[sortEntries_[i].index];
+    cmds.swap(sortedCmds_);
+}
+
+// ----------------------------------------------------------------------
+// GeometryList
+// ----------------------------------------------------------------------
+void GeometryList::Clear()
+{
+    vertices.clear();
+    indices.clear();
+    batches.clear();
+}
+
+void GeometryList::Build(const DrawList& list)
+{
+    Clear();
+    // Sized up front and written through pointers: with particles this
+    // loop runs over 100k+ quads a frame
+    vertices.resize(list.cmds.size() * 4);
+    indices.resize(list.cmds.size() * 6);
+    SDL_Vertex* v   = vertices.data();
+    int*        idx = indices.data();
+
+    for (const DrawCmd& cmd : list.cmds) {
+        const SDL_FRect& d = cmd.dst;
+        const float u0 = cmd.uv.x;
+        const float v0 = cmd.uv.y;
+        const float u1 = cmd.uv.x + cmd.uv.w;
+        const float v1 = cmd.uv.y + cmd.uv.h;
+
+        // Corners clockwise from top-left
+        SDL_FPoint corners[4] = {
+            { d.x,       d.y       },
+            { d.x + d.w, d.y       },
+            { d.x + d.w, d.y + d.h },
+            { d.x,       d.y + d.h },
+        };
+        if (cmd.angle != 0.f) {
+            const float rad = cmd.angle * (SDL_PI_F / 180.f);
+            const float c   = std::cos(rad);
+            const float s   = std::sin(rad);
+            const float cx  = d.x + d.w * 0.5f;
+            const float cy  = d.y + d.h * 0.5f;
+            for (SDL_FPoint& p : corners) {
+                float dx = p.x - cx;
+                float dy = p.y - cy;
+                p.x = cx + dx * c - dy * s;
+                p.y = cy + dx * s + dy * c;
+            }
+        }
+
+        const int base = (int)(v - vertices.data());
+        v[0] = SDL_Vertex{ corners[0], cmd.color, { u0, v0 } };
+        v[1] = SDL_Vertex{ corners[1], cmd.color, { u1, v0 } };
+        v[2] = SDL_Vertex{ corners[2], cmd.color, { u1, v1 } };
+        v[3] = SDL_Vertex{ corners[3], cmd.color, { u0, v1 } };
+        v += 4;
+
+        if (batches.empty() || batches.back().texture != cmd.texture ||
+            batches.back().blend != cmd.blend || batches.back().wrap || cmd.wrap) {
+            batches.push_back(GeometryBatch{ cmd.texture, (int)(idx - indices.data()), 0,
+                                             cmd.wrap, cmd.blend });
+        }
+        const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int q : quad) *idx++ = base + q;
+        batches.back().indexCount += 6;
+    }
+}
+
+// ----------------------------------------------------------------------
+// Backend selection
+// ----------------------------------------------------------------------
+bool ParseRenderBackend(const char* name, RenderBackendKind& out)
+{
+    if (std::strcmp(name, "sdl") == 0)      { out = RenderBackendKind::SdlRenderer; return true; }
+    if (std::strcmp(name, "software") == 0) { out = RenderBackendKind::Software;    return true; }
+    if (std::strcmp(name, "gpu") == 0)      { out = RenderBackendKind::Gpu;         return true; }
+    if (std::strcmp(name, "null") == 0)     { out = RenderBackendKind::Null;        return true; }
+    return false;
+}
+
+const char* RenderBackendName(RenderBackendKind kind)
+{
+    switch (kind) {
+    case RenderBackendKind::SdlRenderer: return "sdl";
+    case RenderBackendKind::Software:    return "software";
+    case RenderBackendKind::Gpu:         return "gpu";
+    case RenderBackendKind::Null:        return "null";
+    }
+    return "?";
+}
+
+RenderBackendKind DefaultRenderBackend()
+{
+#if defined(FLIPMAN_RENDER_BACKEND_SOFTWARE)
+    return RenderBackendKind::Software;
+#elif defined(FLIPMAN_RENDER_BACKEND_GPU)
+    return RenderBackendKind::Gpu;
+#elif defined(FLIPMAN_RENDER_BACKEND_NULL)
+    return RenderBackendKind::Null;
+#else
+    return RenderBackendKind::SdlRenderer;
+#endif
+}
+
+std::unique_ptr<RenderBackend> CreateRenderBackend(RenderBackendKind kind)
+{
+    switch (kind) {
+    case RenderBackendKind::SdlRenderer: return std::make_unique<SdlRendererBackend>();
+    case RenderBackendKind::Software:    return std::make_unique<SoftwareBackend>();
+    case RenderBackendKind::Gpu:         return std::make_unique<GpuBackend>();
+    case RenderBackendKind::Null:        return std::make_unique<NullBackend>();
+    }
+    return nullptr;
+}
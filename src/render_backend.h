@@ -0,0 +1,180 @@
+// src/render_backend.h - Backend-neutral draw lists and the renderer interface
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "render_stats.h"
+
+class FrameCapture;
+
+// Textures are referred to by a small handle the backend hands out, so
+// scene code never touches SDL_Texture / SDL_GPUTexture directly.
+using TextureId = Uint32;
+constexpr TextureId kNoTexture = 0;
+
+// One quad: a sprite (texture + normalised uv) or, with kNoTexture, a
+// solid rectangle in `color`. `angle` is in degrees, clockwise around
+// the centre of `dst`, like SDL_RenderTextureRotated.
+//
+// With `wrap`, the whole texture repeats across `dst`: uv is then
+// { 0, 0, tiles across, tiles down }, starting with a full tile at the
+// top-left (like SDL_RenderTextureTiled). Only for standalone textures,
+// never atlas sprites, and never rotated.
+//
+// `layer`, then `depth`, decide draw order once the list is sorted (see
+// DrawList::Sort); within the same layer and depth, commands are grouped
+// by blend mode and texture.
+struct DrawCmd
+{
+    TextureId     texture = kNoTexture;
+    SDL_FRect     dst{};
+    SDL_FRect     uv{ 0.f, 0.f, 1.f, 1.f };
+    float         angle   = 0.f;
+    SDL_FColor    color{ 1.f, 1.f, 1.f, 1.f };
+    bool          wrap    = false;
+    Uint8         layer   = 0;
+    Uint16        depth   = 0;
+    SDL_BlendMode blend   = SDL_BLENDMODE_BLEND;
+};
+
+// Sort key, most significant first: layer (8 bits), depth (16), blend
+// mode (8), texture (32). Equal keys keep their push order.
+// Depth sits above texture, not below it: depth is draw order within a
+// layer (the parallax layers overlap and must go back to front), so it
+// can't give way to batching. Layers that don't care leave every depth
+// at 0, and there commands still group by blend mode, then texture.
+Uint64 DrawSortKey(const DrawCmd& cmd);
+
+// Everything one pass of scene traversal wants drawn. Commands are drawn
+// in list order, so call Sort() once the list is complete.
+struct DrawList
+{
+    SDL_FColor           clearColor{ 18 / 255.f, 18 / 255.f, 28 / 255.f, 1.f };
+    std::vector<DrawCmd> cmds;
+
+    void Clear() { cmds.clear(); }
+    void Push(const DrawCmd& cmd) { cmds.push_back(cmd); }
+
+    // Stable LSD radix sort of cmds by DrawSortKey, 8 bits per pass.
+    // Passes where every key has the same byte are skipped, which with
+    // few layers and textures is most of them; a list already in key
+    // order is left alone after one pass over it.
+    void Sort();
+
+private:
+    struct SortEntry
+    {
+        Uint64 key;
+        Uint32 index;
+    };
+    std::vector<SortEntry> sortEntries_; // scratch, kept between frames
+    std::vector<SortEntry> sortTemp_;
+    std::vector<DrawCmd>   sortedCmds_;
+};
+
+// A draw list turned into triangles: two per quad, rotation applied on
+// the CPU, and one batch per run of commands sharing a texture and blend
+// mode. This is what an SDL_RenderGeometry-based backend submits. A wrap
+// command is always a batch of its own, so a backend can tile it natively.
+struct GeometryBatch
+{
+    TextureId     texture;
+    int           firstIndex;
+    int           indexCount;
+    bool          wrap;
+    SDL_BlendMode blend;
+};
+
+struct GeometryList
+{
+    std::vector<SDL_Vertex>    vertices;
+    std::vector<int>           indices;
+    std::vector<GeometryBatch> batches;
+
+    void Clear();
+    void Build(const DrawList& list);
+};
+
+enum class RenderBackendKind
+{
+    SdlRenderer, // SDL_Renderer with whatever driver SDL picks
+    Software,    // SDL's software renderer drawing into the window surface
+    Gpu,         // SDL_GPU instanced sprites (see gpu_renderer.h)
+    Null,        // builds draw lists and geometry, then drops them
+};
+
+// Parse "sdl" / "software" / "gpu" / "null". Returns false on unknown names.
+bool ParseRenderBackend(const char* name, RenderBackendKind& out);
+const char* RenderBackendName(RenderBackendKind kind);
+
+// The backend picked at build time with -DFLIPMAN_RENDER_BACKEND=<name>
+RenderBackendKind DefaultRenderBackend();
+
+// A frame is DrawStatic, DrawDynamic, Present. The static list (screen-
+// fixed content) is only rebuilt by the caller when `version` changes, so
+// a backend is free to cache whatever it derives from it.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual RenderBackendKind Kind() const = 0;
+
+    // Take over `window`. Returns false (after cleaning up) if the backend
+    // is unavailable, so the caller can fall back to another one.
+    virtual bool Init(SDL_Window* window, bool vsync) = 0;
+    virtual void Shutdown() = 0;
+
+    // Whether presenting actually waits for the display refresh
+    virtual bool VSyncActive() const = 0;
+
+    // Upload a surface. The surface is not freed. Returns kNoTexture on failure.
+    virtual TextureId CreateTexture(SDL_Surface* surf) = 0;
+    virtual void      DestroyTexture(TextureId tex) = 0;
+
+    virtual void DrawStatic(const DrawList& list, Uint64 version) = 0;
+    virtual void DrawDynamic(const DrawList& list) = 0;
+    virtual void Present() = 0;
+
+    // Cached GPU-side contents were lost (render targets / device reset)
+    virtual void InvalidateCaches() {}
+
+    // Render the following frames at `scale` (0..1] times the output
+    // resolution and upscale when presenting. Ignored by backends that
+    // produce no pixels.
+    virtual void SetResolutionScale(float) {}
+
+    // Text lines drawn over every following frame at window pixel size,
+    // with SDL_RenderDebugText; empty to hide. Only the SDL_Renderer
+    // backends draw it.
+    virtual void SetOverlay(const std::vector<std::string>&) {}
+
+    // Capture the frame about to be drawn (call before DrawStatic). Its
+    // pixels are read back a few frames later, when the GPU is long done
+    // with it, and handed to `sink`; pending frames are flushed in
+    // Shutdown(), so `sink` must outlive it. Ignored by backends that
+    // produce no pixels.
+    virtual void CaptureFrame(FrameCapture&) {}
+
+    // Counters for the last presented frame
+    const RenderStats& FrameStats() const { return lastStats_; }
+
+protected:
+    // Backends add to frameStats_ while drawing (uploads between frames
+    // count towards the next one) and call this when presenting.
+    void FinishFrameStats()
+    {
+        lastStats_  = frameStats_;
+        frameStats_ = RenderStats{};
+    }
+
+    RenderStats frameStats_;
+
+private:
+    RenderStats lastStats_;
+};
+
+std::unique_ptr<RenderBackend> CreateRenderBackend(RenderBackendKind kind);
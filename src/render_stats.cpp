@@ -0,0 +1,78 @@
+// src/render_stats.cpp - Per-frame renderer counters, overlay text and CSV log
+#include "render_stats.h"
+
+#include <iostream>
+
+std::vector<std::string> FormatRenderStats(const RenderStats& stats, const char* backendName,
+                                           double frameMs, float resolutionScale)
+{
+    char line[128];
+    std::vector<std::string> lines;
+
+    SDL_snprintf(line, sizeof(line), "%s  %.2f ms  scale %.2f",
+                 backendName, frameMs, resolutionScale);
+    lines.push_back(line);
+    SDL_snprintf(line, sizeof(line), "draws %u  verts %u  binds %u",
+                 stats.drawCalls, stats.vertices, stats.textureBinds);
+    lines.push_back(line);
+    SDL_snprintf(line, sizeof(line), "targets %u  upload %.1f KiB",
+                 stats.targetSwitches, (double)stats.bytesUploaded / 1024.0);
+    lines.push_back(line);
+    return lines;
+}
+
+bool RenderStatsLog::Open(const std::string& path)
+{
+    Close();
+    path_ = path;
+    io_   = SDL_IOFromFile(path.c_str(), "w");
+    if (!io_) {
+        std::cerr << "Render stats: cannot open '" << path << "' for writing: "
+                  << SDL_GetError() << "\n";
+        return false;
+    }
+    frames_ = 0;
+    ok_     = true;
+    buffer_ = "frame,work_us,draw_calls,vertices,texture_binds,target_switches,bytes_uploaded\n";
+    return true;
+}
+
+void RenderStatsLog::Add(const RenderStats& stats, Uint64 workNS)
+{
+    if (!io_) return;
+
+    char row[160];
+    SDL_snprintf(row, sizeof(row), "%u,%.1f,%u,%u,%u,%u,%llu\n",
+                 (unsigned)frames_++, (double)workNS / 1000.0,
+                 stats.drawCalls, stats.vertices, stats.textureBinds, stats.targetSwitches,
+                 (unsigned long long)stats.bytesUploaded);
+    buffer_ += row;
+    if (buffer_.size() >= kFlushBytes) Flush();
+}
+
+bool RenderStatsLog::Flush()
+{
+    if (ok_ && !buffer_.empty() &&
+        SDL_WriteIO(io_, buffer_.data(), buffer_.size()) != buffer_.size()) {
+        std::cerr << "Render stats: write to '" << path_ << "' failed: " << SDL_GetError()
+                  << " - no more rows.\n";
+        ok_ = false;
+    }
+    buffer_.clear();
+    return ok_;
+}
+
+bool RenderStatsLog::Close()
+{
+    if (!io_) return false;
+
+    Flush();
+    if (!SDL_CloseIO(io_) && ok_) {
+        std::cerr << "Render stats: closing '" << path_ << "' failed: " << SDL_GetError() << "\n";
+        ok_ = false;
+    }
+    io_ = nullptr;
+
+    if (ok_) std::cout << "Render stats: wrote " << frames_ << " frames to '" << path_ << "'\n";
+    return ok_;
+}
@@ -0,0 +1,57 @@
+// src/render_stats.h - Per-frame renderer counters, overlay text and CSV log
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+// What one frame asked of the renderer. Backends count what they submit,
+// so a batching regression shows up as more draw calls or binds for the
+// same scene. The stats overlay itself is not counted.
+struct RenderStats
+{
+    Uint32 drawCalls      = 0; // geometry, tiled and full-screen texture draws
+    Uint32 vertices       = 0; // vertices submitted, 6 per quad
+    Uint32 textureBinds   = 0; // texture changes between draw calls
+    Uint32 targetSwitches = 0; // render-target changes (caches, scaled scene)
+    Uint64 bytesUploaded  = 0; // texture data plus per-frame vertex / instance data
+};
+
+// The overlay text for `stats`, one string per line
+std::vector<std::string> FormatRenderStats(const RenderStats& stats, const char* backendName,
+                                           double frameMs, float resolutionScale);
+
+// Every frame's stats as CSV, one row per frame: frame, work_us, then
+// the counters. Rows are buffered and written every kFlushBytes, so memory
+// stays flat over a long session and a crash loses only the last few
+// seconds.
+class RenderStatsLog
+{
+public:
+    RenderStatsLog() = default;
+    ~RenderStatsLog() { Close(); }
+
+    RenderStatsLog(const RenderStatsLog&) = delete;
+    RenderStatsLog& operator=(const RenderStatsLog&) = delete;
+
+    // Create the file and write the header. Returns false (after logging)
+    // on I/O errors; Add() then does nothing.
+    bool Open(const std::string& path);
+
+    void Add(const RenderStats& stats, Uint64 workNS);
+
+    // Write what's buffered and close the file. Returns false if it was
+    // never opened or (after logging) if any write failed.
+    bool Close();
+
+private:
+    static constexpr size_t kFlushBytes = 16 * 1024; // ~300 rows
+
+    bool Flush();
+
+    SDL_IOStream* io_     = nullptr;
+    std::string   path_;
+    std::string   buffer_;
+    Uint32        frames_ = 0;
+    bool          ok_     = true;
+};
@@ -0,0 +1,170 @@
+// src/replay.cpp - Recording and playback of per-tick simulation input
+#include "replay.h"
+
+#include <cstring>
+#include <iostream>
+
+static const char   kReplayMagic[4] = { 'F', 'M', 'R', 'P' };
+static const Uint16 kReplayVersion  = 1;
+
+enum : Uint8
+{
+    kBitLeft  = 1 << 0,
+    kBitRight = 1 << 1,
+    kBitFlip  = 1 << 2,
+};
+
+static Uint8 PackInput(const TickInput& in)
+{
+    return (Uint8)((in.left  ? kBitLeft  : 0) |
+                   (in.right ? kBitRight : 0) |
+                   (in.flip  ? kBitFlip  : 0));
+}
+
+static TickInput UnpackInput(Uint8 bits)
+{
+    TickInput in;
+    in.left  = (bits & kBitLeft)  != 0;
+    in.right = (bits & kBitRight) != 0;
+    in.flip  = (bits & kBitFlip)  != 0;
+    return in;
+}
+
+// FNV-1a over the raw bytes of each float
+static void HashFloat(Uint32& h, float f)
+{
+    Uint8 bytes[sizeof(float)];
+    std::memcpy(bytes, &f, sizeof(float));
+    for (Uint8 b : bytes) {
+        h ^= b;
+        h *= 16777619u;
+    }
+}
+
+Uint32 PlayerChecksum(const PlayerState& p)
+{
+    Uint32 h = 2166136261u;
+    HashFloat(h, p.rect.x);
+    HashFloat(h, p.rect.y);
+    HashFloat(h, p.vx);
+    HashFloat(h, p.vy);
+    HashFloat(h, p.gravityDir);
+    HashFloat(h, p.angle);
+    return h;
+}
+
+// ----------------------------------------------------------------------
+// ReplayWriter
+// ----------------------------------------------------------------------
+void ReplayWriter::Record(const TickInput& in)
+{
+    Uint8 bits = PackInput(in);
+    if (!runs_.empty() && runs_.back().bits == bits && runs_.back().length < 0xFFFF) {
+        ++runs_.back().length;
+    } else {
+        runs_.push_back(ReplayRun{ bits, 1 });
+    }
+    ++tickCount_;
+}
+
+bool ReplayWriter::Save(const std::string& path, const PlayerState& finalState) const
+{
+    if (tickRate_ <= 0 || tickRate_ > kReplayMaxTickRate) {
+        std::cerr << "Replay: cannot save '" << path << "': tick rate " << tickRate_
+                  << " Hz is outside the format's 1.." << kReplayMaxTickRate << " Hz.\n";
+        return false;
+    }
+
+    SDL_IOStream* io = SDL_IOFromFile(path.c_str(), "wb");
+    if (!io) {
+        std::cerr << "Replay: cannot open '" << path << "' for writing: "
+                  << SDL_GetError() << "\n";
+        return false;
+    }
+
+    bool ok = SDL_WriteIO(io, kReplayMagic, sizeof(kReplayMagic)) == sizeof(kReplayMagic) &&
+              SDL_WriteU16LE(io, kReplayVersion) &&
+              SDL_WriteU16LE(io, (Uint16)tickRate_) &&
+              SDL_WriteU32LE(io, tickCount_) &&
+              SDL_WriteU32LE(io, PlayerChecksum(finalState)) &&
+              SDL_WriteU32LE(io, (Uint32)runs_.size());
+
+    for (size_t i = 0; ok && i < runs_.size(); ++i) {
+        ok = SDL_WriteU8(io, runs_[i].bits) &&
+             SDL_WriteU16LE(io, runs_[i].length);
+    }
+
+    if (!SDL_CloseIO(io)) ok = false;
+
+    if (!ok) {
+        std::cerr << "Replay: write to '" << path << "' failed: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    std::cout << "Replay: saved " << tickCount_ << " ticks (" << runs_.size()
+              << " runs) to '" << path << "'\n";
+    return true;
+}
+
+// ----------------------------------------------------------------------
+// ReplayReader
+// ----------------------------------------------------------------------
+bool ReplayReader::Load(const std::string& path)
+{
+    SDL_IOStream* io = SDL_IOFromFile(path.c_str(), "rb");
+    if (!io) {
+        std::cerr << "Replay: cannot open '" << path << "': " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    char   magic[4] = {};
+    Uint16 version  = 0;
+    Uint16 tickRate = 0;
+    Uint32 runCount = 0;
+
+    bool ok = SDL_ReadIO(io, magic, sizeof(magic)) == sizeof(magic) &&
+              std::memcmp(magic, kReplayMagic, sizeof(magic)) == 0 &&
+              SDL_ReadU16LE(io, &version) && version == kReplayVersion &&
+              SDL_ReadU16LE(io, &tickRate) && tickRate > 0 &&
+              SDL_ReadU32LE(io, &tickCount_) &&
+              SDL_ReadU32LE(io, &checksum_) &&
+              SDL_ReadU32LE(io, &runCount);
+
+    runs_.clear();
+    Uint64 covered = 0;
+    for (Uint32 i = 0; ok && i < runCount; ++i) {
+        ReplayRun run{};
+        ok = SDL_ReadU8(io, &run.bits) && SDL_ReadU16LE(io, &run.length);
+        if (ok && run.length > 0) {
+            runs_.push_back(run);
+            covered += run.length;
+        }
+    }
+    SDL_CloseIO(io);
+
+    if (!ok || covered != tickCount_) {
+        std::cerr << "Replay: '" << path << "' is not a valid v"
+                  << kReplayVersion << " replay.\n";
+        runs_.clear();
+        return false;
+    }
+
+    tickRate_ = tickRate;
+    runIndex_ = 0;
+    runPos_   = 0;
+    return true;
+}
+
+bool ReplayReader::Next(TickInput& out)
+{
+    if (runIndex_ >= runs_.size()) return false;
+
+    const ReplayRun& run = runs_[runIndex_];
+    out = UnpackInput(run.bits);
+
+    if (++runPos_ >= run.length) {
+        ++runIndex_;
+        runPos_ = 0;
+    }
+    return true;
+}
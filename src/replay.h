@@ -0,0 +1,78 @@
+// src/replay.h - Recording and playback of per-tick simulation input
+//
+// File layout (all integers little-endian):
+//
+//   "FMRP"          magic
+//   u16 version     currently 1
+//   u16 tickRate    simulation rate the inputs were recorded at
+//   u32 tickCount   total ticks covered by the runs
+//   u32 checksum    PlayerChecksum() of the final state, 0 if unknown
+//   u32 runCount
+//   runCount x { u8 bits, u16 length }
+//
+// Each run repeats one TickInput (bit 0 = left, 1 = right, 2 = flip) for
+// `length` ticks, so a held key costs 3 bytes per ~9 minutes at 120 Hz.
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+#include "sim.h"
+
+// Stable hash of the simulation-relevant parts of a player state.
+Uint32 PlayerChecksum(const PlayerState& p);
+
+// The fastest tick rate the header's u16 field can hold
+constexpr int kReplayMaxTickRate = 0xFFFF;
+
+// One TickInput repeated for `length` consecutive ticks
+struct ReplayRun
+{
+    Uint8  bits;
+    Uint16 length;
+};
+
+class ReplayWriter
+{
+public:
+    explicit ReplayWriter(int tickRate) : tickRate_(tickRate) {}
+
+    void Record(const TickInput& in);
+
+    // Write everything recorded so far. finalState is hashed into the
+    // header so playback can check it ends up in the same place. Fails
+    // (with a message) for tick rates above kReplayMaxTickRate rather
+    // than saving a truncated rate.
+    bool Save(const std::string& path, const PlayerState& finalState) const;
+
+    Uint32 TickCount() const { return tickCount_; }
+
+private:
+    int                    tickRate_;
+    Uint32                 tickCount_ = 0;
+    std::vector<ReplayRun> runs_;
+};
+
+class ReplayReader
+{
+public:
+    bool Load(const std::string& path);
+
+    // Fetch the input for the next tick. Returns false once the replay is
+    // exhausted.
+    bool Next(TickInput& out);
+
+    int    TickRate() const  { return tickRate_; }
+    Uint32 TickCount() const { return tickCount_; }
+    Uint32 Checksum() const  { return checksum_; }
+
+private:
+    int                    tickRate_  = 0;
+    Uint32                 tickCount_ = 0;
+    Uint32                 checksum_  = 0;
+    std::vector<ReplayRun> runs_;
+
+    size_t runIndex_ = 0; // playback cursor
+    Uint16 runPos_   = 0;
+};
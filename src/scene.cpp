@@ -0,0 +1,138 @@
+// src/scene.cpp - Scene traversal: world state -> backend-neutral draw lists
+#include "scene.h"
+
+#include <cmath>
+#include <vector>
+
+#include "atlas.h"
+#include "camera.h"
+#include "level.h"
+#include "sim.h"
+
+static const SDL_FColor kWhite{ 1.f, 1.f, 1.f, 1.f };
+static const SDL_FColor kGray{ 120 / 255.f, 120 / 255.f, 120 / 255.f, 1.f };
+static const SDL_FColor kGreen{ 0.f, 200 / 255.f, 0.f, 1.f };
+
+// The part of `dst` a trimmed sprite's pixels cover. Quads rotate about
+// their own centre, so that centre is swung round the full sprite's
+// centre first.
+static SDL_FRect TrimmedDst(const SDL_FRect& dst, const SDL_FRect& trim, float angle)
+{
+    const float w  = dst.w * trim.w;
+    const float h  = dst.h * trim.h;
+    float       ox = dst.w * (trim.x + trim.w * 0.5f - 0.5f); // centre offset
+    float       oy = dst.h * (trim.y + trim.h * 0.5f - 0.5f);
+    if (angle != 0.f) {
+        const float rad = angle * (SDL_PI_F / 180.f);
+        const float c = std::cos(rad), s = std::sin(rad);
+        const float rx = ox * c - oy * s;
+        oy = ox * s + oy * c;
+        ox = rx;
+    }
+    return SDL_FRect{ dst.x + dst.w * 0.5f + ox - w * 0.5f,
+                      dst.y + dst.h * 0.5f + oy - h * 0.5f, w, h };
+}
+
+// A sprite quad, or a solid one in `fallback` when the sprite is missing
+static DrawCmd SpriteCmd(const Sprite* sprite, const SDL_FRect& dst, float angle,
+                         SDL_FColor fallback)
+{
+    DrawCmd cmd;
+    cmd.dst = dst;
+    if (sprite) {
+        cmd.texture = sprite->page;
+        cmd.uv      = sprite->uv;
+        cmd.angle   = angle;
+        cmd.color   = kWhite;
+        cmd.blend   = sprite->blend;
+        if (sprite->trim.w < 1.f || sprite->trim.h < 1.f) {
+            cmd.dst = TrimmedDst(dst, sprite->trim, angle);
+        }
+    } else {
+        cmd.color = fallback; // solid rects are drawn unrotated
+    }
+    return cmd;
+}
+
+DrawCmd WallStyle(const SceneAssets& assets)
+{
+    DrawCmd style = SpriteCmd(assets.wall, SDL_FRect{}, 0.f, kGray);
+    style.layer = kLayerWalls;
+    return style;
+}
+
+// One wrapped quad covering the layer's band of the view. The quad starts
+// on a tile boundary just left of the screen, so it always begins with a
+// whole tile and is at most one tile wider than the view.
+static void PushLayer(const ParallaxLayer& layer, Uint16 depth, float camX, float camY,
+                      DrawList& out)
+{
+    if (layer.texture == kNoTexture || layer.tileW <= 0.f || layer.tileH <= 0.f) return;
+
+    float shift = std::fmod(camX * layer.factor, layer.tileW);
+    if (shift < 0.f) shift += layer.tileW;
+
+    DrawCmd cmd;
+    cmd.texture = layer.texture;
+    cmd.wrap    = true;
+    cmd.layer   = kLayerBackground;
+    cmd.depth   = depth;
+    cmd.blend   = layer.blend;
+    cmd.dst     = SDL_FRect{ -shift, layer.y - camY * layer.factor,
+                             std::ceil((kViewW + shift) / layer.tileW) * layer.tileW,
+                             layer.height };
+    cmd.uv      = SDL_FRect{ 0.f, 0.f, cmd.dst.w / layer.tileW, layer.height / layer.tileH };
+    out.Push(cmd);
+}
+
+void BuildStaticDrawList(const SceneAssets& assets, DrawList& out)
+{
+    out.Clear();
+
+    for (size_t i = 0; i < assets.layers.size(); ++i) {
+        const ParallaxLayer& layer = assets.layers[i];
+        if (layer.factor == 0.f) PushLayer(layer, (Uint16)i, 0.f, 0.f, out);
+    }
+    out.Sort();
+}
+
+void BuildWorldDrawList(const Level& level, const Camera& camera, const PlayerState& view,
+                        const SceneAssets& assets, int benchSprites, float seconds,
+                        DrawList& out)
+{
+    out.Clear();
+
+    for (size_t i = 0; i < assets.layers.size(); ++i) {
+        const ParallaxLayer& layer = assets.layers[i];
+        if (layer.factor != 0.f) PushLayer(layer, (Uint16)i, camera.View().x, camera.View().y, out);
+    }
+
+    // Resident chunks under the view, then each chunk's wall grid. Grid
+    // cells are coarse, so check each candidate against the view too.
+    static thread_local std::vector<const LevelChunk*> chunks;
+    static thread_local std::vector<int>               visible;
+    chunks.clear();
+    level.VisibleChunks(camera.View(), chunks);
+
+    for (const LevelChunk* chunk : chunks) {
+        visible.clear();
+        chunk->wallGrid.Query(camera.View(), visible);
+        for (int idx : visible) {
+            if (!SDL_HasRectIntersectionFloat(&chunk->walls[idx], &camera.View())) continue;
+            DrawCmd cmd = chunk->batch[idx];
+            cmd.dst = camera.WorldToScreen(cmd.dst);
+            out.Push(cmd);
+        }
+    }
+
+    for (int i = 0; i < benchSprites; ++i) {
+        SDL_FRect r{ (float)(i % 100) * 8.f, 40.f + (float)((i / 100) % 65) * 8.f, 8.f, 12.f };
+        DrawCmd cmd = SpriteCmd(assets.player, r, seconds * 90.f + (float)i, kGreen);
+        cmd.layer = kLayerSprites;
+        out.Push(cmd);
+    }
+
+    DrawCmd player = SpriteCmd(assets.player, camera.WorldToScreen(view.rect), view.angle, kGreen);
+    player.layer = kLayerPlayer;
+    out.Push(player);
+}
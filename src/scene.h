@@ -0,0 +1,68 @@
+// src/scene.h - Scene traversal: world state -> backend-neutral draw lists
+#pragma once
+
+#include <vector>
+
+#include "render_backend.h"
+
+class Camera;
+class Level;
+struct PlayerState;
+struct Sprite;
+
+// Draw order between kinds of content (DrawCmd::layer). A sorted list is
+// grouped by texture within a layer, so only content that never overlaps,
+// or doesn't mind the order, may share one.
+enum DrawLayer : Uint8
+{
+    kLayerBackground = 0, // parallax layers, depth = index back to front
+    kLayerWalls,
+    kLayerSprites,        // --bench-sprites
+    kLayerPlayer,
+    kLayerEffects,        // particles
+};
+
+// One background layer: a small texture repeated across a horizontal
+// band of the view. It scrolls at `factor` times the camera speed, so 0
+// is fixed to the screen (and goes in the static list) and 1 moves with
+// the walls.
+struct ParallaxLayer
+{
+    TextureId texture = kNoTexture;
+    float     tileW   = 0.f;    // one repeat, in view units
+    float     tileH   = 0.f;
+    float     y       = 0.f;    // top of the band with the camera at the origin
+    float     height  = 0.f;    // band height (tiles repeat down it too)
+    float     factor  = 0.f;
+    SDL_BlendMode blend = SDL_BLENDMODE_BLEND; // NONE for an opaque back layer
+};
+
+// What the scene draws with. Missing sprites fall back to solid quads
+// (green player, gray walls); missing layers leave the clear color.
+struct SceneAssets
+{
+    const Sprite* player = nullptr;
+    const Sprite* wall   = nullptr;
+    std::vector<ParallaxLayer> layers; // back to front
+};
+
+// Template command for wall tiles (sprite, or gray when missing); the
+// level bakes it into each chunk's render batch.
+DrawCmd WallStyle(const SceneAssets& assets);
+
+// The screen-fixed background (layers with factor 0), sorted. Doesn't
+// depend on the camera, so callers rebuild it rarely and bump the version
+// they pass to DrawStatic.
+void BuildStaticDrawList(const SceneAssets& assets, DrawList& out);
+
+// Everything seen through the camera, in view coordinates (unsorted, so
+// callers can append more before DrawList::Sort): the scrolling
+// parallax layers, the walls
+// overlapping the view (resident chunks under it, then each chunk's
+// wallGrid, so the cost tracks what is visible rather than the level
+// size) and the player.
+// `benchSprites` extra spinning player sprites are added on screen as a
+// batching / throughput load.
+void BuildWorldDrawList(const Level& level, const Camera& camera, const PlayerState& view,
+                        const SceneAssets& assets, int benchSprites, float seconds,
+                        DrawList& out);
@@ -0,0 +1,347 @@
+// src/sdl_backend.cpp - SDL_Renderer and software-surface render backends
+#include "sdl_backend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "frame_capture.h"
+#include "sim.h"
+
+// ----------------------------------------------------------------------
+// SdlRendererBackend
+// ----------------------------------------------------------------------
+bool SdlRendererBackend::CreateRenderer(SDL_Window* window)
+{
+    ren_ = SDL_CreateRenderer(window, nullptr);
+    if (!ren_) {
+        std::cerr << "SDL_CreateRenderer error: " << SDL_GetError() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool SdlRendererBackend::Init(SDL_Window* window, bool vsync)
+{
+    if (!CreateRenderer(window)) return false;
+
+    if (vsync) {
+        vsync_ = SDL_SetRenderVSync(ren_, 1);
+        if (!vsync_) {
+            std::cerr << "SDL_SetRenderVSync failed: " << SDL_GetError() << "\n";
+        }
+    } else {
+        // Don't let the driver default sneak vsync into the other modes
+        SDL_SetRenderVSync(ren_, SDL_RENDERER_VSYNC_DISABLED);
+    }
+    return true;
+}
+
+void SdlRendererBackend::Shutdown()
+{
+    if (ren_) ReadBackCaptures(~(Uint64)0);
+    for (SDL_Texture*& tex : captureRing_) {
+        if (tex) SDL_DestroyTexture(tex);
+        tex = nullptr;
+    }
+
+    staticLayer_.Destroy();
+    if (scene_) SDL_DestroyTexture(scene_);
+    scene_ = nullptr;
+    for (SDL_Texture* tex : textures_) {
+        if (tex) SDL_DestroyTexture(tex);
+    }
+    textures_.clear();
+
+    if (ren_) SDL_DestroyRenderer(ren_);
+    ren_ = nullptr;
+}
+
+TextureId SdlRendererBackend::CreateTexture(SDL_Surface* surf)
+{
+    if (!surf) return kNoTexture;
+
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(ren_, surf);
+    if (!tex) {
+        std::cerr << "SDL_CreateTextureFromSurface failed: " << SDL_GetError() << "\n";
+        return kNoTexture;
+    }
+    textures_.push_back(tex);
+    frameStats_.bytesUploaded += (Uint64)surf->pitch * (Uint64)surf->h;
+    return (TextureId)textures_.size();
+}
+
+void SdlRendererBackend::DestroyTexture(TextureId tex)
+{
+    if (tex == kNoTexture || tex > textures_.size()) return;
+
+    SDL_Texture*& slot = textures_[tex - 1];
+    if (slot) SDL_DestroyTexture(slot);
+    slot = nullptr;
+}
+
+SDL_Texture* SdlRendererBackend::Lookup(TextureId tex) const
+{
+    if (tex == kNoTexture || tex > textures_.size()) return nullptr;
+    return textures_[tex - 1];
+}
+
+// Geometry draws upload their vertices every time; texture copies don't
+void SdlRendererBackend::CountDraw(SDL_Texture* tex, int vertices)
+{
+    frameStats_.drawCalls += 1;
+    frameStats_.vertices  += (Uint32)vertices;
+    if (tex && tex != boundTexture_) {
+        frameStats_.textureBinds += 1;
+        boundTexture_ = tex;
+    }
+}
+
+void SdlRendererBackend::SubmitTiled(const GeometryList& geometry, const GeometryBatch& b)
+{
+    SDL_Texture* tex = Lookup(b.texture);
+    if (!tex) return;
+
+    // One quad: corner 0 is the top-left, corner 2 the bottom-right
+    const SDL_Vertex* v = &geometry.vertices[(size_t)geometry.indices[(size_t)b.firstIndex]];
+    SDL_FRect dst{ v[0].position.x, v[0].position.y,
+                   v[2].position.x - v[0].position.x, v[2].position.y - v[0].position.y };
+    float tilesX = v[2].tex_coord.x - v[0].tex_coord.x;
+
+    float texW = 0.f, texH = 0.f;
+    SDL_GetTextureSize(tex, &texW, &texH);
+    if (tilesX <= 0.f || texW <= 0.f) return;
+
+    SDL_SetTextureColorModFloat(tex, v[0].color.r, v[0].color.g, v[0].color.b);
+    SDL_SetTextureAlphaModFloat(tex, v[0].color.a);
+    SDL_SetTextureBlendMode(tex, b.blend);
+    if (!SDL_RenderTextureTiled(ren_, tex, nullptr, dst.w / (tilesX * texW), &dst)) {
+        std::cerr << "SDL_RenderTextureTiled failed: " << SDL_GetError() << "\n";
+    }
+    CountDraw(tex, 6);
+}
+
+void SdlRendererBackend::Submit(const GeometryList& geometry)
+{
+    for (const GeometryBatch& b : geometry.batches) {
+        if (b.wrap) {
+            SubmitTiled(geometry, b);
+            continue;
+        }
+        // Geometry uses the texture's blend mode, or the draw blend mode
+        // when untextured
+        SDL_Texture* tex = Lookup(b.texture);
+        if (tex) SDL_SetTextureBlendMode(tex, b.blend);
+        else     SDL_SetRenderDrawBlendMode(ren_, b.blend);
+        if (!SDL_RenderGeometry(ren_, tex,
+                                geometry.vertices.data(), (int)geometry.vertices.size(),
+                                geometry.indices.data() + b.firstIndex, b.indexCount)) {
+            std::cerr << "SDL_RenderGeometry failed: " << SDL_GetError() << "\n";
+        }
+        CountDraw(tex, b.indexCount);
+        frameStats_.bytesUploaded += (Uint64)b.indexCount * sizeof(SDL_Vertex);
+    }
+}
+
+void SdlRendererBackend::CaptureFrame(FrameCapture& sink)
+{
+    captureSink_      = &sink;
+    captureThisFrame_ = true;
+}
+
+void SdlRendererBackend::ReadBackCaptures(Uint64 maxFrame)
+{
+    // Oldest first, so frames reach the sink in order
+    for (int i = 0; i < kCaptureSlots; ++i) {
+        const int slot = (captureSlot_ + i) % kCaptureSlots;
+        if (!captureFull_[slot] || captureFrame_[slot] > maxFrame) continue;
+
+        captureFull_[slot] = false;
+        SDL_SetRenderTarget(ren_, captureRing_[slot]);
+        SDL_Surface* frame = SDL_RenderReadPixels(ren_, nullptr);
+        SDL_SetRenderTarget(ren_, nullptr);
+        frameStats_.targetSwitches += 2;
+        if (!frame) {
+            std::cerr << "Capture: SDL_RenderReadPixels failed: " << SDL_GetError() << "\n";
+            continue;
+        }
+        captureSink_->Submit(frame);
+    }
+}
+
+void SdlRendererBackend::CopyToCapture()
+{
+    float w = 0.f, h = 0.f;
+    SDL_GetTextureSize(scene_, &w, &h);
+
+    SDL_Texture*& slot = captureRing_[captureSlot_];
+    if (captureFull_[captureSlot_]) ReadBackCaptures(captureFrame_[captureSlot_]); // ring overrun
+
+    float slotW = 0.f, slotH = 0.f;
+    if (slot) SDL_GetTextureSize(slot, &slotW, &slotH);
+    if (!slot || slotW != w || slotH != h) {
+        if (slot) SDL_DestroyTexture(slot);
+        slot = SDL_CreateTexture(ren_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                 (int)w, (int)h);
+        if (!slot) {
+            std::cerr << "Capture: SDL_CreateTexture failed: " << SDL_GetError() << "\n";
+            return;
+        }
+        SDL_SetTextureBlendMode(slot, SDL_BLENDMODE_NONE);
+    }
+
+    SDL_SetRenderTarget(ren_, slot);
+    SDL_SetRenderScale(ren_, 1.f, 1.f);
+    SDL_RenderTexture(ren_, scene_, nullptr, nullptr);
+    frameStats_.targetSwitches += 1;
+    CountDraw(scene_, 6);
+
+    captureFrame_[captureSlot_] = frameCounter_;
+    captureFull_[captureSlot_]  = true;
+    captureSlot_ = (captureSlot_ + 1) % kCaptureSlots;
+}
+
+void SdlRendererBackend::BeginScene()
+{
+    // The render queue is empty here, and earlier frames are done on the GPU
+    if (frameCounter_ >= kCaptureLatency) ReadBackCaptures(frameCounter_ - kCaptureLatency);
+
+    int outW = 0, outH = 0;
+    SDL_GetCurrentRenderOutputSize(ren_, &outW, &outH);
+    int w = std::max(1, (int)std::lround(outW * resScale_));
+    int h = std::max(1, (int)std::lround(outH * resScale_));
+
+    sceneActive_ = false;
+    // Captured frames always go through scene_, which can be copied
+    if ((resScale_ < 1.f || captureThisFrame_) && !sceneUnsupported_) {
+        float texW = 0.f, texH = 0.f;
+        if (scene_) SDL_GetTextureSize(scene_, &texW, &texH);
+        if (!scene_ || (int)texW != w || (int)texH != h) {
+            if (scene_) SDL_DestroyTexture(scene_);
+            scene_ = SDL_CreateTexture(ren_, SDL_PIXELFORMAT_RGBA8888,
+                                       SDL_TEXTUREACCESS_TARGET, w, h);
+            if (!scene_) {
+                std::cerr << "Scene target: SDL_CreateTexture failed: " << SDL_GetError()
+                          << " - rendering at full size, captures read the window"
+                             " back directly (stalls).\n";
+                sceneUnsupported_ = true;
+            } else {
+                SDL_SetTextureBlendMode(scene_, SDL_BLENDMODE_NONE);
+                SDL_SetTextureScaleMode(scene_, SDL_SCALEMODE_LINEAR);
+            }
+        }
+        sceneActive_ = scene_ && SDL_SetRenderTarget(ren_, scene_);
+        if (sceneActive_) frameStats_.targetSwitches += 1;
+    }
+    if (!sceneActive_) {
+        w = outW;
+        h = outH;
+    }
+
+    // Draw lists are in view units (kViewW x kViewH)
+    SDL_SetRenderScale(ren_, w / kViewW, h / kViewH);
+}
+
+void SdlRendererBackend::DrawStatic(const DrawList& list, Uint64 version)
+{
+    BeginScene();
+
+    if (!haveStatic_ || version != staticVersion_) {
+        staticGeometry_.Build(list);
+        staticClear_   = list.clearColor;
+        staticVersion_ = version;
+        haveStatic_    = true;
+        staticLayer_.Invalidate();
+    }
+
+    boundTexture_ = nullptr;
+    staticLayer_.Draw(ren_, [this]() {
+        SDL_SetRenderDrawColorFloat(ren_, staticClear_.r, staticClear_.g,
+                                    staticClear_.b, staticClear_.a);
+        SDL_RenderClear(ren_);
+        Submit(staticGeometry_);
+    }, frameStats_);
+}
+
+void SdlRendererBackend::DrawDynamic(const DrawList& list)
+{
+    dynamicGeometry_.Build(list);
+    Submit(dynamicGeometry_);
+}
+
+void SdlRendererBackend::DrawOverlay()
+{
+    if (overlay_.empty()) return;
+
+    // Window pixels, over a dark box so it reads on any background
+    constexpr float kLine = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 4.f;
+    size_t longest = 0;
+    for (const std::string& line : overlay_) longest = std::max(longest, line.size());
+
+    SDL_SetRenderScale(ren_, 1.f, 1.f);
+    SDL_FRect box{ 4.f, 4.f, longest * (float)SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE + 8.f,
+                   overlay_.size() * kLine + 4.f };
+    SDL_SetRenderDrawBlendMode(ren_, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(ren_, 0, 0, 0, 160);
+    SDL_RenderFillRect(ren_, &box);
+
+    SDL_SetRenderDrawColor(ren_, 255, 255, 255, 255);
+    for (size_t i = 0; i < overlay_.size(); ++i) {
+        SDL_RenderDebugText(ren_, 8.f, 8.f + i * kLine, overlay_[i].c_str());
+    }
+}
+
+void SdlRendererBackend::Present()
+{
+    if (sceneActive_) {
+        if (captureThisFrame_) CopyToCapture();
+
+        // Stretch the reduced-resolution frame over the window
+        SDL_SetRenderTarget(ren_, nullptr);
+        SDL_SetRenderScale(ren_, 1.f, 1.f);
+        SDL_RenderTexture(ren_, scene_, nullptr, nullptr);
+        sceneActive_ = false;
+        frameStats_.targetSwitches += 1;
+        CountDraw(scene_, 6);
+    } else if (captureThisFrame_) {
+        // No scene target to copy: read the window now, waiting on the GPU
+        SDL_Surface* frame = SDL_RenderReadPixels(ren_, nullptr);
+        if (frame) {
+            captureSink_->Submit(frame);
+        } else {
+            std::cerr << "Capture: SDL_RenderReadPixels failed: " << SDL_GetError() << "\n";
+        }
+    }
+    captureThisFrame_ = false;
+    DrawOverlay();
+    SDL_RenderPresent(ren_);
+    FinishFrameStats();
+    ++frameCounter_;
+}
+
+// ----------------------------------------------------------------------
+// SoftwareBackend
+// ----------------------------------------------------------------------
+bool SoftwareBackend::CreateRenderer(SDL_Window* window)
+{
+    SDL_Surface* surf = SDL_GetWindowSurface(window);
+    if (!surf) {
+        std::cerr << "SDL_GetWindowSurface error: " << SDL_GetError() << "\n";
+        return false;
+    }
+    ren_ = SDL_CreateSoftwareRenderer(surf);
+    if (!ren_) {
+        std::cerr << "SDL_CreateSoftwareRenderer error: " << SDL_GetError() << "\n";
+        return false;
+    }
+    window_ = window;
+    return true;
+}
+
+void SoftwareBackend::Present()
+{
+    SdlRendererBackend::Present();
+    if (!SDL_UpdateWindowSurface(window_)) {
+        std::cerr << "SDL_UpdateWindowSurface failed: " << SDL_GetError() << "\n";
+    }
+}
@@ -0,0 +1,105 @@
+// src/sdl_backend.h - SDL_Renderer and software-surface render backends
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+#include "render_backend.h"
+#include "static_layer.h"
+
+// Draw lists become triangle batches submitted with SDL_RenderGeometry:
+// the static list is batched once per version and kept in a StaticLayer
+// render target, the dynamic list is batched every frame. Below full
+// resolution the frame is drawn into a smaller scene target and stretched
+// over the window in Present.
+class SdlRendererBackend : public RenderBackend
+{
+public:
+    RenderBackendKind Kind() const override { return RenderBackendKind::SdlRenderer; }
+
+    bool Init(SDL_Window* window, bool vsync) override;
+    void Shutdown() override;
+    bool VSyncActive() const override { return vsync_; }
+
+    TextureId CreateTexture(SDL_Surface* surf) override;
+    void      DestroyTexture(TextureId tex) override;
+
+    void DrawStatic(const DrawList& list, Uint64 version) override;
+    void DrawDynamic(const DrawList& list) override;
+    void Present() override;
+
+    void InvalidateCaches() override { staticLayer_.Invalidate(); }
+    void SetResolutionScale(float scale) override { resScale_ = scale; }
+    void SetOverlay(const std::vector<std::string>& lines) override { overlay_ = lines; }
+    void CaptureFrame(FrameCapture& sink) override;
+
+protected:
+    // Create ren_ for `window`; the software backend overrides this
+    virtual bool CreateRenderer(SDL_Window* window);
+
+    SDL_Texture* Lookup(TextureId tex) const;
+    void         CountDraw(SDL_Texture* tex, int vertices);
+    void         Submit(const GeometryList& geometry);
+    void         SubmitTiled(const GeometryList& geometry, const GeometryBatch& batch);
+
+    // Point rendering at the window or the scaled scene target and map
+    // world units onto it. Called at the start of DrawStatic.
+    void BeginScene();
+    void DrawOverlay();
+
+    // Copy the finished scene into the next capture slot (in Present)
+    void CopyToCapture();
+    // Read back capture slots filled on or before frame `maxFrame`
+    void ReadBackCaptures(Uint64 maxFrame);
+
+    SDL_Renderer* ren_   = nullptr;
+    bool          vsync_ = false;
+
+    std::vector<SDL_Texture*> textures_; // TextureId - 1 -> texture
+
+    StaticLayer  staticLayer_;
+    GeometryList staticGeometry_;
+    SDL_FColor   staticClear_{};
+    Uint64       staticVersion_ = 0;
+    bool         haveStatic_    = false;
+
+    GeometryList dynamicGeometry_;
+    SDL_Texture* boundTexture_ = nullptr; // last texture drawn with, for bind counts
+    std::vector<std::string> overlay_;
+
+    float        resScale_         = 1.f;
+    SDL_Texture* scene_            = nullptr; // reduced-resolution frame
+    bool         sceneActive_      = false;   // this frame goes through scene_
+    bool         sceneUnsupported_ = false;   // target creation failed once
+
+    // Frame capture: the scene is copied into a ring of target textures
+    // and each is read back kCaptureLatency frames later, at the start of
+    // a frame, so SDL_RenderReadPixels finds the GPU done with it.
+    // Without a scene target (sceneUnsupported_), Present() reads the
+    // window back directly instead, which stalls that frame.
+    static constexpr int    kCaptureSlots   = 3;
+    static constexpr Uint64 kCaptureLatency = 2;
+    FrameCapture* captureSink_      = nullptr;
+    bool          captureThisFrame_ = false;
+    SDL_Texture*  captureRing_[kCaptureSlots] = {};
+    Uint64        captureFrame_[kCaptureSlots] = {}; // frame each slot holds
+    bool          captureFull_[kCaptureSlots] = {};
+    int           captureSlot_  = 0; // next slot to fill, also the oldest
+    Uint64        frameCounter_ = 0;
+};
+
+// SDL's software rasteriser drawing into the window surface, which is
+// then pushed with SDL_UpdateWindowSurface. No GPU involved at all.
+class SoftwareBackend : public SdlRendererBackend
+{
+public:
+    RenderBackendKind Kind() const override { return RenderBackendKind::Software; }
+
+    void Present() override;
+
+protected:
+    bool CreateRenderer(SDL_Window* window) override;
+
+    SDL_Window* window_ = nullptr;
+};
@@ -0,0 +1,239 @@
+// src/sim.cpp - FlipMan player simulation (gravity, movement, wall collision)
+#include "sim.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "level.h"
+
+// A frame longer than this is treated as a stall (debugger, window drag)
+// and only this much of it is simulated, so we never spiral trying to
+// catch up.
+static constexpr Uint64 kMaxFrameNS = SDL_NS_PER_SECOND / 4;
+
+// Gaps smaller than this (in pixels) count as touching, so float error
+// after snapping to a wall face never lets the player sink through it.
+static constexpr float kSkin = 0.01f;
+
+// Resting contact and sliding along a wall each need one pass, plus one
+// spare for corners.
+static constexpr int kMaxSweepPasses = 4;
+
+// Box covering `r` before and after moving by (dx, dy)
+static SDL_FRect SweptBounds(const SDL_FRect& r, float dx, float dy)
+{
+    SDL_FRect out;
+    out.x = std::min(r.x, r.x + dx);
+    out.y = std::min(r.y, r.y + dy);
+    out.w = r.w + std::fabs(dx);
+    out.h = r.h + std::fabs(dy);
+    return out;
+}
+
+// Entry/exit time of a moving interval [a0, a1] against a static one
+// [b0, b1] along a single axis. Returns false if they can never overlap.
+static bool AxisInterval(float a0, float a1, float b0, float b1, float d,
+                         float& tEntry, float& tExit)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+
+    if (d == 0.f) {
+        if (a1 <= b0 || a0 >= b1) return false;
+        tEntry = -inf;
+        tExit  =  inf;
+        return true;
+    }
+
+    float entryGap = (d > 0.f) ? b0 - a1 : a0 - b1; // distance to first contact
+    float exitGap  = (d > 0.f) ? b1 - a0 : a1 - b0; // distance to separation
+    if (std::fabs(entryGap) < kSkin) entryGap = 0.f;
+
+    tEntry = entryGap / std::fabs(d);
+    tExit  = exitGap  / std::fabs(d);
+    return true;
+}
+
+// Swept AABB: time of impact in [0, 1] of `box` moving by (dx, dy)
+// against `wall`, and the axis it hits on (0 = x, 1 = y).
+static bool SweepAABB(const SDL_FRect& box, float dx, float dy,
+                      const SDL_FRect& wall, float& tHit, int& axis)
+{
+    float txEntry, txExit, tyEntry, tyExit;
+    if (!AxisInterval(box.x, box.x + box.w, wall.x, wall.x + wall.w, dx, txEntry, txExit)) return false;
+    if (!AxisInterval(box.y, box.y + box.h, wall.y, wall.y + wall.h, dy, tyEntry, tyExit)) return false;
+
+    float tEntry = std::max(txEntry, tyEntry);
+    float tExit  = std::min(txExit, tyExit);
+
+    // Already overlapping (handled by Depenetrate), out of reach this
+    // step, or only grazing a corner.
+    if (tEntry < 0.f || tEntry > 1.f || tEntry >= tExit) return false;
+
+    tHit = tEntry;
+    axis = (tyEntry >= txEntry) ? 1 : 0; // prefer landing on corners
+    return true;
+}
+
+// Minimal push-out from any wall the player already overlaps.
+static void Depenetrate(PlayerState& p, const Level& level)
+{
+    SDL_FRect& player = p.rect;
+
+    static thread_local std::vector<SDL_FRect> candidates;
+    candidates.clear();
+    level.QueryColliders(player, candidates);
+
+    for (const SDL_FRect& w : candidates) {
+
+        float overlapLeft   = (player.x + player.w) - w.x;
+        float overlapRight  = (w.x + w.w) - player.x;
+        float overlapTop    = (player.y + player.h) - w.y;
+        float overlapBottom = (w.y + w.h) - player.y;
+
+        float minHoriz = std::min(overlapLeft, overlapRight);
+        float minVert  = std::min(overlapTop, overlapBottom);
+        if (minHoriz <= kSkin || minVert <= kSkin) continue; // not inside
+
+        if (minVert < minHoriz) {
+            if (overlapTop < overlapBottom) {
+                player.y = w.y - player.h;       // out through the top
+                if (p.vy > 0.f) p.vy = 0.f;
+            } else {
+                player.y = w.y + w.h;            // out through the bottom
+                if (p.vy < 0.f) p.vy = 0.f;
+            }
+        } else {
+            if (overlapLeft < overlapRight) {
+                player.x = w.x - player.w;       // out to the left
+                if (p.vx > 0.f) p.vx = 0.f;
+            } else {
+                player.x = w.x + w.w;            // out to the right
+                if (p.vx < 0.f) p.vx = 0.f;
+            }
+        }
+    }
+}
+
+// Move by (dx, dy), stopping at the earliest wall contact along the way
+// and sliding the rest of the motion along that wall.
+static void MoveAndCollide(PlayerState& p, const Level& level, float dx, float dy)
+{
+    SDL_FRect& player = p.rect;
+
+    static thread_local std::vector<SDL_FRect> candidates;
+
+    for (int pass = 0; pass < kMaxSweepPasses && (dx != 0.f || dy != 0.f); ++pass) {
+        candidates.clear();
+        level.QueryColliders(SweptBounds(player, dx, dy), candidates);
+
+        float tFirst = 1.f;
+        int   axis   = -1;
+        for (const SDL_FRect& w : candidates) {
+            float t;
+            int   hitAxis;
+            if (SweepAABB(player, dx, dy, w, t, hitAxis) && t < tFirst) {
+                tFirst = t;
+                axis   = hitAxis;
+            }
+        }
+
+        player.x += dx * tFirst;
+        player.y += dy * tFirst;
+        if (axis < 0) break; // reached the destination
+
+        // Stop along the contact normal, keep the tangential remainder
+        float remain = 1.f - tFirst;
+        if (axis == 0) {
+            p.vx = 0.f;
+            dx   = 0.f;
+            dy  *= remain;
+        } else {
+            p.vy = 0.f;
+            dy   = 0.f;
+            dx  *= remain;
+        }
+    }
+}
+
+void StepPlayer(PlayerState& p, const TickInput& in, const Level& level, float dt)
+{
+    SDL_FRect& player = p.rect;
+
+    if (in.flip) {
+        // Flip gravity direction
+        p.gravityDir *= -1.f;
+
+        // Reset vertical velocity to avoid weird residual speeds.
+        p.vy = 0.f;
+
+        // Set target angle based on new gravity direction:
+        // gravity down  -> upright (0°)
+        // gravity up    -> upside down (180°)
+        p.targetAngle = (p.gravityDir > 0.f) ? 0.f : 180.f;
+    }
+
+    p.vx = 0.f;
+    if (in.left)  p.vx = -kMoveSpeed;
+    if (in.right) p.vx =  kMoveSpeed;
+
+    // Animate rotation: move angle toward targetAngle
+    if (p.angle < p.targetAngle) {
+        p.angle += kAngleSpeed * dt;
+        if (p.angle > p.targetAngle) p.angle = p.targetAngle;
+    } else if (p.angle > p.targetAngle) {
+        p.angle -= kAngleSpeed * dt;
+        if (p.angle < p.targetAngle) p.angle = p.targetAngle;
+    }
+
+    // Apply gravity
+    p.vy += kGravity * p.gravityDir * dt;
+
+    // Push out of anything we start inside (spawn point, level edits),
+    // then sweep the box along its velocity.
+    Depenetrate(p, level);
+    MoveAndCollide(p, level, p.vx * dt, p.vy * dt);
+
+    // Clamp horizontally within the level
+    const SDL_FRect& b = level.Bounds();
+    if (player.x < b.x) player.x = b.x;
+    if (player.x + player.w > b.x + b.w) player.x = b.x + b.w - player.w;
+}
+
+PlayerState LerpPlayer(const PlayerState& a, const PlayerState& b, float alpha)
+{
+    PlayerState out = b;
+    out.rect.x = a.rect.x + (b.rect.x - a.rect.x) * alpha;
+    out.rect.y = a.rect.y + (b.rect.y - a.rect.y) * alpha;
+    out.angle  = a.angle  + (b.angle  - a.angle)  * alpha;
+    return out;
+}
+
+// ----------------------------------------------------------------------
+// FixedStep
+// ----------------------------------------------------------------------
+FixedStep::FixedStep(int tickRate)
+{
+    if (tickRate <= 0) tickRate = 120;
+    tickNS_ = SDL_NS_PER_SECOND / (Uint64)tickRate;
+    dt_     = (float)((double)tickNS_ / (double)SDL_NS_PER_SECOND);
+}
+
+int FixedStep::Advance(Uint64 frameNS)
+{
+    if (frameNS > kMaxFrameNS) {
+        droppedNS_ += frameNS - kMaxFrameNS;
+        frameNS = kMaxFrameNS;
+    }
+
+    accumulatorNS_ += frameNS;
+    int ticks = (int)(accumulatorNS_ / tickNS_);
+    accumulatorNS_ -= (Uint64)ticks * tickNS_;
+    return ticks;
+}
+
+float FixedStep::Alpha() const
+{
+    return (float)((double)accumulatorNS_ / (double)tickNS_);
+}
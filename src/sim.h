@@ -0,0 +1,72 @@
+// src/sim.h - FlipMan player simulation (gravity, movement, wall collision)
+#pragma once
+
+#include <SDL3/SDL.h>
+
+class Level;
+
+// ----------------------------------------------------------------------
+// View / physics constants
+// ----------------------------------------------------------------------
+// Size of the camera view in world units (the level itself can be larger)
+constexpr float kViewW      = 800.f;
+constexpr float kViewH      = 600.f;
+
+constexpr float kGravity    = 900.f; // constant magnitude
+constexpr float kMoveSpeed  = 240.f;
+constexpr float kAngleSpeed = 720.f; // degrees per second (how fast we rotate)
+
+// ----------------------------------------------------------------------
+// Player state advanced by one simulation tick
+// ----------------------------------------------------------------------
+struct PlayerState
+{
+    SDL_FRect rect{ 380.f, 500.f, 40.f, 60.f }; // x, y, w, h (standing on the floor)
+
+    float vx = 0.f;
+    float vy = 0.f;
+
+    float gravityDir  = 1.f; // +1 = gravity down, -1 = gravity up
+    float angle       = 0.f; // current angle in degrees
+    float targetAngle = 0.f; // target angle (0 or 180)
+};
+
+// Input sampled for a single simulation tick
+struct TickInput
+{
+    bool left  = false;
+    bool right = false;
+    bool flip  = false; // SPACE was pressed since the previous tick
+};
+
+// Advance the player by exactly dt seconds against the level's walls.
+void StepPlayer(PlayerState& p, const TickInput& in, const Level& level, float dt);
+
+// Blend two consecutive states for rendering (alpha in [0, 1]).
+PlayerState LerpPlayer(const PlayerState& a, const PlayerState& b, float alpha);
+
+// ----------------------------------------------------------------------
+// Fixed-timestep clock: turns wall-clock nanoseconds into whole ticks
+// ----------------------------------------------------------------------
+class FixedStep
+{
+public:
+    explicit FixedStep(int tickRate);
+
+    // Feed the time elapsed since the last frame. Returns how many ticks
+    // to run now; the remainder stays in the accumulator.
+    int Advance(Uint64 frameNS);
+
+    // Fraction of a tick left in the accumulator, used to interpolate.
+    float Alpha() const;
+
+    float  Dt() const     { return dt_; }
+    Uint64 TickNS() const { return tickNS_; }
+    Uint64 DroppedNS() const { return droppedNS_; }
+
+private:
+    Uint64 tickNS_;
+    float  dt_;
+    Uint64 accumulatorNS_ = 0;
+    Uint64 droppedNS_     = 0; // time discarded by the spiral-of-death guard
+};
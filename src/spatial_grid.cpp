@@ -0,0 +1,107 @@
+// src/spatial_grid.cpp - Static uniform grid over level rectangles
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool SpatialGrid::Span(const SDL_FRect& r, CellSpan& out) const
+{
+    if (cols_ == 0 || rows_ == 0) return false;
+
+    const float inv = 1.f / cellSize_;
+    out.x0 = (int)std::floor((r.x - originX_) * inv);
+    out.y0 = (int)std::floor((r.y - originY_) * inv);
+    out.x1 = (int)std::floor((r.x + r.w - originX_) * inv);
+    out.y1 = (int)std::floor((r.y + r.h - originY_) * inv);
+
+    if (out.x1 < 0 || out.y1 < 0 || out.x0 >= cols_ || out.y0 >= rows_) return false;
+
+    out.x0 = std::max(out.x0, 0);
+    out.y0 = std::max(out.y0, 0);
+    out.x1 = std::min(out.x1, cols_ - 1);
+    out.y1 = std::min(out.y1, rows_ - 1);
+    return true;
+}
+
+void SpatialGrid::Build(const std::vector<SDL_FRect>& rects, float cellSize)
+{
+    cellSize_ = (cellSize > 0.f) ? cellSize : 64.f;
+    cols_ = rows_ = 0;
+    cellStart_.clear();
+    cellItems_.clear();
+    itemSpans_.assign(rects.size(), CellSpan{ 0, 0, -1, -1 });
+
+    if (rects.empty()) return;
+
+    // Grid covers the bounding box of all rects
+    float minX = rects[0].x, minY = rects[0].y;
+    float maxX = rects[0].x + rects[0].w, maxY = rects[0].y + rects[0].h;
+    for (const auto& r : rects) {
+        minX = std::min(minX, r.x);
+        minY = std::min(minY, r.y);
+        maxX = std::max(maxX, r.x + r.w);
+        maxY = std::max(maxY, r.y + r.h);
+    }
+
+    originX_ = minX;
+    originY_ = minY;
+    cols_ = (int)std::floor((maxX - minX) / cellSize_) + 1;
+    rows_ = (int)std::floor((maxY - minY) / cellSize_) + 1;
+
+    // Two passes: count per cell, prefix-sum into offsets, then scatter
+    const size_t cellCount = (size_t)cols_ * (size_t)rows_;
+    std::vector<int> counts(cellCount, 0);
+
+    for (size_t i = 0; i < rects.size(); ++i) {
+        CellSpan s;
+        if (!Span(rects[i], s)) continue;
+        itemSpans_[i] = s;
+        for (int cy = s.y0; cy <= s.y1; ++cy) {
+            for (int cx = s.x0; cx <= s.x1; ++cx) {
+                ++counts[(size_t)cy * cols_ + cx];
+            }
+        }
+    }
+
+    cellStart_.assign(cellCount + 1, 0);
+    for (size_t c = 0; c < cellCount; ++c) {
+        cellStart_[c + 1] = cellStart_[c] + counts[c];
+    }
+
+    cellItems_.resize(cellStart_[cellCount]);
+    std::vector<int> cursor(cellStart_.begin(), cellStart_.end() - 1);
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const CellSpan& s = itemSpans_[i];
+        for (int cy = s.y0; cy <= s.y1; ++cy) {
+            for (int cx = s.x0; cx <= s.x1; ++cx) {
+                cellItems_[cursor[(size_t)cy * cols_ + cx]++] = (int)i;
+            }
+        }
+    }
+}
+
+void SpatialGrid::Query(const SDL_FRect& bounds, std::vector<int>& out) const
+{
+    CellSpan q;
+    if (!Span(bounds, q)) return;
+
+    const size_t first = out.size();
+    for (int cy = q.y0; cy <= q.y1; ++cy) {
+        for (int cx = q.x0; cx <= q.x1; ++cx) {
+            size_t cell = (size_t)cy * cols_ + cx;
+            for (int k = cellStart_[cell]; k < cellStart_[cell + 1]; ++k) {
+                int item = cellItems_[k];
+                const CellSpan& s = itemSpans_[item];
+
+                // A rect spanning several cells is reported only from the
+                // first cell shared by the rect and the query.
+                if (cx == std::max(s.x0, q.x0) && cy == std::max(s.y0, q.y0)) {
+                    out.push_back(item);
+                }
+            }
+        }
+    }
+
+    // Callers resolve in index order, same as walking the full list
+    std::sort(out.begin() + first, out.end());
+}
@@ -0,0 +1,50 @@
+// src/spatial_grid.h - Static uniform grid over level rectangles
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Buckets a fixed set of rectangles into square cells once, then answers
+// "which rects might touch this box" by visiting only the covered cells.
+// Cell contents are stored flat (one offset table + one index array), so
+// a query touches a couple of cache lines instead of the whole level.
+class SpatialGrid
+{
+public:
+    // (Re)build the index. Indices returned by Query refer to `rects`.
+    void Build(const std::vector<SDL_FRect>& rects, float cellSize = 64.f);
+
+    // Append the index of every rect whose cells overlap `bounds` to
+    // `out`, each exactly once, in ascending order.
+    void Query(const SDL_FRect& bounds, std::vector<int>& out) const;
+
+    int   Cols() const     { return cols_; }
+    int   Rows() const     { return rows_; }
+    float CellSize() const { return cellSize_; }
+
+    // Heap memory held by the index
+    size_t Bytes() const
+    {
+        return (cellStart_.capacity() + cellItems_.capacity()) * sizeof(int)
+             + itemSpans_.capacity() * sizeof(CellSpan);
+    }
+
+private:
+    struct CellSpan
+    {
+        int x0, y0, x1, y1; // inclusive
+    };
+
+    // Cells covered by a rect, clamped to the grid. False if none.
+    bool Span(const SDL_FRect& r, CellSpan& out) const;
+
+    float originX_  = 0.f;
+    float originY_  = 0.f;
+    float cellSize_ = 64.f;
+    int   cols_     = 0;
+    int   rows_     = 0;
+
+    std::vector<int>      cellStart_; // cols*rows + 1 offsets into cellItems_
+    std::vector<int>      cellItems_; // rect indices, grouped by cell
+    std::vector<CellSpan> itemSpans_; // cells covered by each rect
+};
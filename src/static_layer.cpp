@@ -0,0 +1,74 @@
+// src/static_layer.cpp - Screen-fixed content cached in a render-target texture
+#include "static_layer.h"
+
+#include <iostream>
+
+#include "sim.h"
+
+bool StaticLayer::Rebuild(SDL_Renderer* ren, const std::function<void()>& drawScene,
+                          RenderStats& stats)
+{
+    int outW = 0, outH = 0;
+    if (!SDL_GetCurrentRenderOutputSize(ren, &outW, &outH) || outW <= 0 || outH <= 0) {
+        return false;
+    }
+
+    if (!target_ || outW != width_ || outH != height_) {
+        if (target_) SDL_DestroyTexture(target_);
+        target_ = SDL_CreateTexture(ren, SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_TARGET, outW, outH);
+        if (!target_) {
+            std::cerr << "Static layer: SDL_CreateTexture failed: " << SDL_GetError()
+                      << " - drawing static content every frame.\n";
+            unsupported_ = true;
+            return false;
+        }
+        // The layer is opaque and covers the screen, so skip blending
+        SDL_SetTextureBlendMode(target_, SDL_BLENDMODE_NONE);
+        width_  = outW;
+        height_ = outH;
+    }
+
+    SDL_Texture* prevTarget = SDL_GetRenderTarget(ren);
+    float prevScaleX = 1.f, prevScaleY = 1.f;
+    SDL_GetRenderScale(ren, &prevScaleX, &prevScaleY);
+
+    SDL_SetRenderTarget(ren, target_);
+    SDL_SetRenderScale(ren, outW / kViewW, outH / kViewH);
+    drawScene();
+    SDL_SetRenderScale(ren, prevScaleX, prevScaleY);
+    SDL_SetRenderTarget(ren, prevTarget);
+    stats.targetSwitches += 2;
+
+    dirty_ = false;
+    return true;
+}
+
+void StaticLayer::Draw(SDL_Renderer* ren, const std::function<void()>& drawScene,
+                       RenderStats& stats)
+{
+    if (!unsupported_) {
+        int outW = 0, outH = 0;
+        SDL_GetCurrentRenderOutputSize(ren, &outW, &outH);
+        if (dirty_ || outW != width_ || outH != height_) {
+            Rebuild(ren, drawScene, stats);
+        }
+    }
+
+    if (target_ && !dirty_) {
+        SDL_RenderTexture(ren, target_, nullptr, nullptr);
+        stats.drawCalls    += 1;
+        stats.vertices     += 6;
+        stats.textureBinds += 1;
+    } else {
+        drawScene();
+    }
+}
+
+void StaticLayer::Destroy()
+{
+    if (target_) SDL_DestroyTexture(target_);
+    target_ = nullptr;
+    width_ = height_ = 0;
+    dirty_ = true;
+}
@@ -0,0 +1,35 @@
+// src/static_layer.h - Screen-fixed content cached in a render-target texture
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <functional>
+
+#include "render_stats.h"
+
+// Content that doesn't move with the camera is rendered once into an
+// SDL_TEXTUREACCESS_TARGET texture and each frame is a single full-screen
+// copy of it. The cache is redrawn only after Invalidate() (new content,
+// lost render targets) or when the output size changes.
+class StaticLayer
+{
+public:
+    void Invalidate() { dirty_ = true; }
+
+    // Draw the layer, refreshing the cache first if needed. `drawScene`
+    // renders the static content in view coordinates; it is called into
+    // the cache, or straight to the screen if render targets are unsupported.
+    // The cache's target switches and copy are added to `stats`.
+    void Draw(SDL_Renderer* ren, const std::function<void()>& drawScene, RenderStats& stats);
+
+    // Release the cached texture. Call before destroying the renderer.
+    void Destroy();
+
+private:
+    bool Rebuild(SDL_Renderer* ren, const std::function<void()>& drawScene, RenderStats& stats);
+
+    SDL_Texture* target_      = nullptr;
+    int          width_       = 0;
+    int          height_      = 0;
+    bool         dirty_       = true;
+    bool         unsupported_ = false; // target creation failed once
+};
@@ -0,0 +1,185 @@
+// src/texture_cache.cpp - Shared standalone textures: interned IDs, ref counts, LRU budget
+#include "texture_cache.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "asset_pack.h"
+
+TextureCache::TextureCache(RenderBackend& backend, AssetLoader& loader, Uint64 budgetBytes)
+    : backend_(backend)
+    , loader_(loader)
+    , budget_(budgetBytes)
+{
+}
+
+AssetId TextureCache::Intern(const std::string& name)
+{
+    std::string key = name;
+    for (char& c : key) c = AssetPackNormalize(c);
+
+    auto it = ids_.find(key);
+    if (it != ids_.end()) return it->second;
+
+    entries_.emplace_back();
+    entries_.back().name = name;
+    const AssetId id = (AssetId)entries_.size();
+    ids_.emplace(std::move(key), id);
+    return id;
+}
+
+const std::string& TextureCache::Name(AssetId id) const
+{
+    static const std::string kNone;
+    return Valid(id) ? entries_[id - 1].name : kNone;
+}
+
+void TextureCache::Acquire(AssetId id, OnReady onReady)
+{
+    if (!Valid(id)) {
+        std::cerr << "Textures: acquire of invalid asset id " << id << ".\n";
+        if (onReady) onReady(nullptr);
+        return;
+    }
+    Entry& e = At(id);
+    if (e.refs++ == 0 && e.state == State::Resident) lru_.erase(e.lruPos);
+
+    switch (e.state) {
+    case State::Resident:
+        ++hits_;
+        if (onReady) onReady(&e.tex);
+        break;
+    case State::Failed:
+        if (onReady) onReady(nullptr);
+        break;
+    case State::Loading:
+        if (onReady) e.waiting.push_back(std::move(onReady));
+        break;
+    case State::Unloaded:
+        e.state = State::Loading;
+        if (onReady) e.waiting.push_back(std::move(onReady));
+        ++loads_;
+        loader_.Load(e.name, [this, id](SDL_Surface* surf, const ImageMeta& meta) {
+            OnLoaded(id, surf, meta);
+        });
+        break;
+    }
+}
+
+void TextureCache::Release(AssetId id)
+{
+    if (id == kNoAsset) return;
+    if (!Valid(id)) {
+        std::cerr << "Textures: release of invalid asset id " << id << ".\n";
+        return;
+    }
+    Entry& e = At(id);
+    if (e.refs <= 0) {
+        std::cerr << "Textures: '" << e.name << "' released more often than acquired.\n";
+        return;
+    }
+    if (--e.refs > 0 || e.state != State::Resident) return;
+
+    e.lruPos = lru_.insert(lru_.end(), id);
+    Trim();
+}
+
+const CachedTexture* TextureCache::Find(AssetId id) const
+{
+    if (!Valid(id)) return nullptr;
+    const Entry& e = entries_[id - 1];
+    return e.state == State::Resident ? &e.tex : nullptr;
+}
+
+void TextureCache::OnLoaded(AssetId id, SDL_Surface* surf, const ImageMeta& meta)
+{
+    Entry& e = At(id);
+    if (e.state != State::Loading) { // cleared (and maybe reloaded) while in flight
+        SDL_DestroySurface(surf);
+        return;
+    }
+
+    TextureId tex = surf ? backend_.CreateTexture(surf) : kNoTexture;
+    if (tex == kNoTexture) {
+        e.state = State::Failed;
+    } else {
+        e.state     = State::Resident;
+        e.tex       = CachedTexture{ tex, surf->w, surf->h, meta, (Uint64)surf->w * surf->h * 4 };
+        residentBytes_ += e.tex.bytes;
+        ++residentCount_;
+        peakBytes_ = std::max(peakBytes_, ResidentBytes());
+        if (e.refs == 0) e.lruPos = lru_.insert(lru_.end(), id);
+    }
+    SDL_DestroySurface(surf);
+
+    // The callbacks may acquire or release, so run them from a local list
+    std::vector<OnReady> waiting;
+    waiting.swap(e.waiting);
+    for (const OnReady& onReady : waiting) {
+        onReady(Find(id));
+    }
+    Trim();
+}
+
+void TextureCache::Evict(AssetId id)
+{
+    Entry& e = At(id);
+    backend_.DestroyTexture(e.tex.texture);
+    residentBytes_ -= e.tex.bytes;
+    --residentCount_;
+    e.tex   = CachedTexture{};
+    e.state = State::Unloaded;
+}
+
+void TextureCache::Trim()
+{
+    while (ResidentBytes() > budget_ && !lru_.empty()) {
+        const AssetId id = lru_.front();
+        lru_.pop_front();
+        Evict(id);
+        ++evictions_;
+    }
+}
+
+void TextureCache::SetBudget(Uint64 budgetBytes)
+{
+    budget_ = budgetBytes;
+    Trim();
+}
+
+void TextureCache::SetExternalBytes(Uint64 bytes)
+{
+    externalBytes_ = bytes;
+    Trim();
+    peakBytes_ = std::max(peakBytes_, ResidentBytes());
+}
+
+void TextureCache::Clear()
+{
+    lru_.clear();
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        Entry& e = entries_[i];
+        if (e.state == State::Resident) Evict((AssetId)i + 1);
+        e.state = State::Unloaded; // loads in flight are dropped when they land
+        e.refs  = 0;
+        e.waiting.clear();
+    }
+}
+
+std::string TextureCache::Summary() const
+{
+    char line[128];
+    SDL_snprintf(line, sizeof(line), "textures %d  vram %.1f / %.1f KiB (atlas %.1f)",
+                 residentCount_, (double)ResidentBytes() / 1024.0, (double)budget_ / 1024.0,
+                 (double)externalBytes_ / 1024.0);
+    return line;
+}
+
+void TextureCache::Report() const
+{
+    std::cout << "Textures: " << loads_ << " loaded, " << hits_ << " cache hits, "
+              << evictions_ << " evicted; " << residentCount_ << " resident ("
+              << ResidentBytes() / 1024 << " KiB with " << externalBytes_ / 1024
+              << " KiB of atlas pages, peak " << peakBytes_ / 1024 << " KiB, budget "
+              << budget_ / 1024 << " KiB)\n";
+}
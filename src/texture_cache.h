@@ -0,0 +1,134 @@
+// src/texture_cache.h - Shared standalone textures: interned IDs, ref counts, LRU budget
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "asset_loader.h"
+#include "cooked_texture.h"
+#include "render_backend.h"
+
+// Asset names interned to small integers, so owners hold and compare an
+// ID instead of a string. 0 is never a valid asset.
+using AssetId = Uint32;
+constexpr AssetId kNoAsset = 0;
+
+// A resident texture, as the cache hands it out
+struct CachedTexture
+{
+    TextureId texture = kNoTexture;
+    int       w       = 0;
+    int       h       = 0;
+    ImageMeta meta;
+    Uint64    bytes   = 0; // estimated VRAM: 4 bytes a pixel, no mipmaps
+};
+
+// Loads each standalone texture (sprites go to the TextureAtlas instead)
+// at most once, however many owners ask for it. Owners Acquire() an asset
+// and Release() it when done; a texture nobody holds stays resident for
+// the next owner until the cache is over its budget, then the least
+// recently released ones go first. Textures in use are never evicted, so
+// the budget is the most kept around *unused* - resident bytes above it
+// all belong to live owners. Render thread only.
+class TextureCache
+{
+public:
+    // The texture, or nullptr if the asset failed to load
+    using OnReady = std::function<void(const CachedTexture* tex)>;
+
+    // Both must outlive the cache
+    TextureCache(RenderBackend& backend, AssetLoader& loader, Uint64 budgetBytes);
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // The ID for an asset name (case-insensitive, as in the pack),
+    // creating it on first use
+    AssetId Intern(const std::string& name);
+    const std::string& Name(AssetId id) const; // "" for kNoAsset / unknown IDs
+
+    // Take a reference to the asset, loading it if it isn't resident.
+    // `onReady` runs once it is: right away when it's already resident
+    // (or has failed), else from AssetLoader::Update(). kNoAsset and
+    // unknown IDs take no reference and fail right away.
+    void Acquire(AssetId id, OnReady onReady = OnReady{});
+
+    // Drop a reference. The texture stays cached until evicted. kNoAsset
+    // is ignored.
+    void Release(AssetId id);
+
+    // The resident texture, or nullptr while loading / not acquired.
+    // Like the one passed to OnReady, the pointer is only good until the
+    // next call into the cache.
+    const CachedTexture* Find(AssetId id) const;
+
+    // Change the budget (e.g. between levels) and evict down to it
+    void   SetBudget(Uint64 budgetBytes);
+    Uint64 Budget() const { return budget_; }
+
+    // VRAM held by textures the cache doesn't own (the atlas pages). It
+    // counts towards the budget like textures in use, so it is never
+    // evicted but leaves less room for unheld ones.
+    void SetExternalBytes(Uint64 bytes);
+
+    // Estimated resident VRAM: cached textures plus external bytes
+    Uint64 ResidentBytes() const { return residentBytes_ + externalBytes_; }
+
+    // Destroy every texture, held or not, and forget all references and
+    // pending callbacks (IDs stay valid). Call before shutting the
+    // backend down.
+    void Clear();
+
+    // One line for the stats overlay: resident textures and all VRAM
+    std::string Summary() const;
+
+    // Print loads, evictions and the VRAM peak to stdout.
+    void Report() const;
+
+private:
+    enum class State
+    {
+        Unloaded,
+        Loading,
+        Resident,
+        Failed,
+    };
+
+    struct Entry
+    {
+        std::string          name;
+        State                state = State::Unloaded;
+        int                  refs  = 0;
+        CachedTexture        tex;
+        std::vector<OnReady> waiting; // while Loading
+        std::list<AssetId>::iterator lruPos; // valid while resident with refs == 0
+    };
+
+    bool   Valid(AssetId id) const { return id != kNoAsset && id <= entries_.size(); }
+    Entry& At(AssetId id) { return entries_[id - 1]; } // Valid(id) only
+    void   OnLoaded(AssetId id, SDL_Surface* surf, const ImageMeta& meta);
+    void   Evict(AssetId id);
+    void   Trim(); // evict unheld textures, oldest release first, down to the budget
+
+    RenderBackend& backend_;
+    AssetLoader&   loader_;
+    Uint64         budget_;
+
+    std::vector<Entry>                       entries_; // by id - 1
+    std::unordered_map<std::string, AssetId> ids_;     // normalised name -> id
+    std::list<AssetId>                       lru_;     // unheld resident textures, oldest first
+
+    Uint64 residentBytes_ = 0; // cached textures only
+    Uint64 externalBytes_ = 0;
+    int    residentCount_ = 0;
+
+    // Stats
+    Uint64 peakBytes_ = 0;
+    int    loads_     = 0;
+    int    hits_      = 0; // acquires that found the texture already resident
+    int    evictions_ = 0;
+};
@@ -0,0 +1,315 @@
+// tools/cook_assets.cpp - Cook an image into a texture blob (see src/cooked_texture.h)
+//
+//   flip-man-cooker <in.png|in.bmp> <out.tex> [manifest]
+//
+// The blob holds premultiplied kCookedFormat pixels, resized to the size
+// the image is drawn at and optionally trimmed to its visible pixels, so
+// the game uploads it without a conversion pass. Per-asset options come
+// from the manifest (assets/cook.txt), one line per file:
+//
+//   <file>  <width> <height>  [trim]
+//
+// Unlisted files, and 0 0, keep their size. Runs at build time on the
+// host, so it uses only the standard library and src/png_decoder.cpp.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cooked_texture.h"
+#include "png_decoder.h"
+
+struct Image
+{
+    int                w = 0;
+    int                h = 0;
+    std::vector<float> rgba; // premultiplied, 0..1, rows top to bottom
+};
+
+struct CookOptions
+{
+    int  width  = 0; // 0: keep
+    int  height = 0;
+    bool trim   = false;
+};
+
+static std::vector<Uint8> ReadFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<Uint8>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static Uint32 U32(const std::vector<Uint8>& d, size_t at)
+{
+    return (Uint32)d[at] | (Uint32)d[at + 1] << 8 | (Uint32)d[at + 2] << 16 | (Uint32)d[at + 3] << 24;
+}
+
+static int MaskShift(Uint32 mask)
+{
+    int shift = 0;
+    while (mask && !(mask & 1u)) {
+        mask >>= 1;
+        ++shift;
+    }
+    return shift;
+}
+
+// Uncompressed 24/32-bit BMPs (BI_RGB or BI_BITFIELDS), as the game ships
+static bool LoadBMP(const std::string& path, const std::vector<Uint8>& d, Image& out)
+{
+    if (d.size() < 54 || d[0] != 'B' || d[1] != 'M') {
+        std::cerr << "flip-man-cooker: '" << path << "' is not a BMP\n";
+        return false;
+    }
+
+    const Uint32 dataAt      = U32(d, 10);
+    const Uint32 headerSize  = U32(d, 14);
+    const int    w           = (int)U32(d, 18);
+    const int    hRaw        = (int)U32(d, 22);
+    const int    bpp         = d[28] | d[29] << 8;
+    const Uint32 compression = U32(d, 30);
+    const int    h           = std::abs(hRaw);
+    if ((bpp != 24 && bpp != 32) || (compression != 0 && compression != 3) || w <= 0 || h == 0) {
+        std::cerr << "flip-man-cooker: '" << path << "': unsupported BMP (" << bpp
+                  << " bpp, compression " << compression << ")\n";
+        return false;
+    }
+
+    Uint32 masks[4] = { 0x00FF0000u, 0x0000FF00u, 0x000000FFu, bpp == 32 ? 0xFF000000u : 0u };
+    if (compression == 3 && d.size() >= 14 + 40 + 12) {
+        for (int c = 0; c < 3; ++c) masks[c] = U32(d, 14 + 40 + 4 * c);
+        masks[3] = headerSize >= 56 ? U32(d, 14 + 40 + 12) : 0u;
+    }
+
+    const size_t pitch = ((size_t)w * (bpp / 8) + 3) & ~(size_t)3;
+    if (dataAt + pitch * h > d.size()) {
+        std::cerr << "flip-man-cooker: '" << path << "' is truncated\n";
+        return false;
+    }
+
+    out.w = w;
+    out.h = h;
+    out.rgba.assign((size_t)w * h * 4, 0.f);
+    bool anyAlpha = false;
+    for (int y = 0; y < h; ++y) {
+        const Uint8* row = &d[dataAt + pitch * (size_t)(hRaw > 0 ? h - 1 - y : y)]; // bottom-up
+        for (int x = 0; x < w; ++x) {
+            Uint32 px = bpp == 32 ? U32(d, (size_t)(row - d.data()) + (size_t)x * 4)
+                                  : (Uint32)row[x * 3] | (Uint32)row[x * 3 + 1] << 8 |
+                                    (Uint32)row[x * 3 + 2] << 16;
+            float* o = &out.rgba[((size_t)y * w + x) * 4];
+            for (int c = 0; c < 4; ++c) {
+                if (!masks[c]) continue;
+                const Uint32 max = masks[c] >> MaskShift(masks[c]);
+                o[c] = (float)((px & masks[c]) >> MaskShift(masks[c])) / (float)max;
+            }
+            anyAlpha |= o[3] > 0.f;
+        }
+    }
+
+    // Like SDL_LoadBMP: an alpha channel that is all zero means opaque
+    for (size_t i = 0; i < out.rgba.size(); i += 4) {
+        if (!anyAlpha) out.rgba[i + 3] = 1.f;
+        for (int c = 0; c < 3; ++c) out.rgba[i + c] *= out.rgba[i + 3];
+    }
+    return true;
+}
+
+// Any PNG, through the game's own decoder
+static bool LoadPNG(const std::string& path, const std::vector<Uint8>& d, Image& out)
+{
+    PngInfo     info;
+    std::string error;
+    std::vector<Uint8> rgba;
+    bool ok = ReadPngInfo(d.data(), d.size(), info, error);
+    if (ok) {
+        rgba.resize((size_t)info.width * info.height * 4);
+        ok = DecodePng(d.data(), d.size(), rgba.data(), (size_t)info.width * 4, error);
+    }
+    if (!ok) {
+        std::cerr << "flip-man-cooker: '" << path << "': " << error << "\n";
+        return false;
+    }
+
+    out.w = (int)info.width;
+    out.h = (int)info.height;
+    out.rgba.resize(rgba.size());
+    for (size_t i = 0; i < rgba.size(); i += 4) {
+        const float a = rgba[i + 3] / 255.f;
+        for (int c = 0; c < 3; ++c) out.rgba[i + c] = rgba[i + c] / 255.f * a;
+        out.rgba[i + 3] = a;
+    }
+    return true;
+}
+
+// Bounding box of the pixels with any alpha. Empty images keep one pixel.
+static void VisibleBounds(const Image& img, int& x0, int& y0, int& x1, int& y1)
+{
+    x0 = img.w;
+    y0 = img.h;
+    x1 = 0;
+    y1 = 0;
+    for (int y = 0; y < img.h; ++y) {
+        for (int x = 0; x < img.w; ++x) {
+            if (img.rgba[((size_t)y * img.w + x) * 4 + 3] <= 0.f) continue;
+            x0 = std::min(x0, x);
+            y0 = std::min(y0, y);
+            x1 = std::max(x1, x + 1);
+            y1 = std::max(y1, y + 1);
+        }
+    }
+    if (x1 <= x0 || y1 <= y0) {
+        x0 = y0 = 0;
+        x1 = y1 = 1;
+    }
+}
+
+static Image Crop(const Image& img, int x0, int y0, int x1, int y1)
+{
+    Image out;
+    out.w = x1 - x0;
+    out.h = y1 - y0;
+    out.rgba.resize((size_t)out.w * out.h * 4);
+    for (int y = 0; y < out.h; ++y) {
+        const float* src = &img.rgba[((size_t)(y0 + y) * img.w + x0) * 4];
+        std::copy(src, src + (size_t)out.w * 4, &out.rgba[(size_t)y * out.w * 4]);
+    }
+    return out;
+}
+
+// One axis of a box filter: each output pixel averages the source span it
+// covers, weighting partly covered pixels by their overlap. Premultiplied
+// input keeps transparent pixels' colour out of the average.
+static Image ResizeAxis(const Image& img, int size, bool horizontal)
+{
+    const int    from  = horizontal ? img.w : img.h;
+    const double scale = (double)from / size;
+
+    Image out;
+    out.w = horizontal ? size : img.w;
+    out.h = horizontal ? img.h : size;
+    out.rgba.assign((size_t)out.w * out.h * 4, 0.f);
+
+    const int lines = horizontal ? img.h : img.w;
+    for (int i = 0; i < size; ++i) {
+        const double s0 = i * scale;
+        const double s1 = std::min((double)from, (i + 1) * scale);
+        for (int line = 0; line < lines; ++line) {
+            float acc[4] = {};
+            double total = 0.0;
+            for (int s = (int)s0; s < (int)std::ceil(s1); ++s) {
+                const double weight = std::min(s1, s + 1.0) - std::max(s0, (double)s);
+                const int x = horizontal ? s : line;
+                const int y = horizontal ? line : s;
+                const float* px = &img.rgba[((size_t)y * img.w + x) * 4];
+                for (int c = 0; c < 4; ++c) acc[c] += (float)(px[c] * weight);
+                total += weight;
+            }
+            const int x = horizontal ? i : line;
+            const int y = horizontal ? line : i;
+            float* o = &out.rgba[((size_t)y * out.w + x) * 4];
+            for (int c = 0; c < 4; ++c) o[c] = total > 0.0 ? (float)(acc[c] / total) : 0.f;
+        }
+    }
+    return out;
+}
+
+static bool ReadOptions(const std::string& manifest, const std::string& file, CookOptions& out)
+{
+    std::ifstream in(manifest);
+    if (!in) {
+        std::cerr << "flip-man-cooker: cannot read manifest '" << manifest << "'\n";
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream words(line);
+        std::string name;
+        if (!(words >> name) || name[0] == '#' || name != file) continue;
+
+        CookOptions opt;
+        std::string flag;
+        words >> opt.width >> opt.height;
+        while (words >> flag) opt.trim |= flag == "trim";
+        out = opt;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <in.png|in.bmp> <out.tex> [manifest]\n";
+        return 2;
+    }
+    const std::string inPath  = argv[1];
+    const std::string outPath = argv[2];
+    const size_t      slash   = inPath.find_last_of("/\\");
+    const std::string file    = slash == std::string::npos ? inPath : inPath.substr(slash + 1);
+
+    CookOptions opt;
+    if (argc > 3 && !ReadOptions(argv[3], file, opt)) return 1;
+
+    Image img;
+    const std::vector<Uint8> data = ReadFile(inPath);
+    if (IsPng(data.data(), data.size()) ? !LoadPNG(inPath, data, img) : !LoadBMP(inPath, data, img)) {
+        return 1;
+    }
+    const int fullW = img.w;
+    const int fullH = img.h;
+    const int drawW = opt.width  > 0 ? opt.width  : fullW;
+    const int drawH = opt.height > 0 ? opt.height : fullH;
+
+    // Trim in source pixels, then scale what's left to its drawn size
+    float trim[4] = { 0.f, 0.f, 1.f, 1.f };
+    if (opt.trim) {
+        int x0, y0, x1, y1;
+        VisibleBounds(img, x0, y0, x1, y1);
+        img = Crop(img, x0, y0, x1, y1);
+        trim[0] = (float)x0 / fullW;
+        trim[1] = (float)y0 / fullH;
+        trim[2] = (float)(x1 - x0) / fullW;
+        trim[3] = (float)(y1 - y0) / fullH;
+    }
+    const int outW = std::max(1, (int)std::lround(drawW * trim[2]));
+    const int outH = std::max(1, (int)std::lround(drawH * trim[3]));
+    if (outW != img.w) img = ResizeAxis(img, outW, true);
+    if (outH != img.h) img = ResizeAxis(img, outH, false);
+
+    CookedTextureHeader header{};
+    std::memcpy(header.magic, kCookedMagic, 4);
+    header.version = kCookedVersion;
+    header.format  = kCookedFormat;
+    header.width   = (Uint32)img.w;
+    header.height  = (Uint32)img.h;
+    header.pitch   = (Uint32)img.w * 4;
+    header.flags   = kCookedPremultiplied;
+    std::copy(trim, trim + 4, header.trim);
+
+    // ARGB8888 as a little-endian word: bytes B, G, R, A
+    std::vector<Uint8> pixels((size_t)header.pitch * img.h);
+    for (size_t i = 0; i < (size_t)img.w * img.h; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            static const int kByteOf[4] = { 2, 1, 0, 3 }; // r, g, b, a
+            const float v = std::clamp(img.rgba[i * 4 + c], 0.f, 1.f);
+            pixels[i * 4 + kByteOf[c]] = (Uint8)std::lround(v * 255.f);
+        }
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)pixels.data(), (std::streamsize)pixels.size());
+    if (!out.flush()) {
+        std::cerr << "flip-man-cooker: write to '" << outPath << "' failed\n";
+        return 1;
+    }
+    std::cout << "flip-man-cooker: " << file << " " << fullW << "x" << fullH << " -> "
+              << img.w << "x" << img.h << (opt.trim ? " (trimmed)" : "") << "\n";
+    return 0;
+}
@@ -0,0 +1,115 @@
+// tools/pack_assets.cpp - Build an asset pack (see src/asset_pack.h) from loose files
+//
+//   flip-man-pack <out.pak> <file>...
+//
+// Each file is stored under its normalised file name ("Wall.bmp" -> "wall.bmp").
+// Runs at build time on the host, so it uses only the standard library.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "asset_pack.h"
+
+struct Input
+{
+    std::string       name; // normalised
+    std::vector<char> data;
+};
+
+static std::string PackName(const std::string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    for (char& c : name) c = AssetPackNormalize(c);
+    return name;
+}
+
+static Uint64 AlignUp(Uint64 v)
+{
+    return (v + kPackAlign - 1) & ~(kPackAlign - 1);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <out.pak> <file>...\n";
+        return 2;
+    }
+
+    std::vector<Input> inputs;
+    for (int i = 2; i < argc; ++i) {
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) {
+            std::cerr << "flip-man-pack: cannot read '" << argv[i] << "'\n";
+            return 1;
+        }
+        Input input;
+        input.name = PackName(argv[i]);
+        input.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        for (const Input& other : inputs) {
+            if (other.name == input.name) {
+                std::cerr << "flip-man-pack: two files named '" << input.name << "'\n";
+                return 1;
+            }
+        }
+        inputs.push_back(std::move(input));
+    }
+
+    // At most half full, so probe runs stay short
+    Uint32 slotCount = 1;
+    while (slotCount < inputs.size() * 2) slotCount *= 2;
+
+    PackHeader header{};
+    std::memcpy(header.magic, kPackMagic, 4);
+    header.version    = kPackVersion;
+    header.slotCount  = slotCount;
+    header.entryCount = (Uint32)inputs.size();
+
+    std::vector<PackSlot> slots(slotCount, PackSlot{});
+    Uint64 namesAt = sizeof(PackHeader) + (Uint64)slotCount * sizeof(PackSlot);
+    Uint64 dataAt  = namesAt;
+    for (const Input& input : inputs) dataAt += input.name.size();
+    dataAt = AlignUp(dataAt);
+
+    std::vector<Uint64> offsets;
+    for (const Input& input : inputs) {
+        PackSlot slot{};
+        slot.hash       = AssetPackHash(input.name.data(), input.name.size());
+        slot.offset     = dataAt;
+        slot.size       = input.data.size();
+        slot.nameOffset = (Uint32)namesAt;
+        slot.nameLength = (Uint32)input.name.size();
+        Uint32 i = (Uint32)slot.hash & (slotCount - 1);
+        while (slots[i].hash != 0) i = (i + 1) & (slotCount - 1);
+        slots[i] = slot;
+
+        offsets.push_back(dataAt);
+        namesAt += input.name.size();
+        dataAt   = AlignUp(dataAt + input.data.size());
+    }
+    header.fileSize = dataAt;
+
+    std::ofstream out(argv[1], std::ios::binary | std::ios::trunc);
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)slots.data(), (std::streamsize)(slots.size() * sizeof(PackSlot)));
+    for (const Input& input : inputs) out.write(input.name.data(), (std::streamsize)input.name.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Uint64 pad = offsets[i] - (Uint64)out.tellp();
+        out.write("\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0", (std::streamsize)pad);
+        out.write(inputs[i].data.data(), (std::streamsize)inputs[i].data.size());
+    }
+    const Uint64 pad = header.fileSize - (Uint64)out.tellp();
+    out.write("\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0", (std::streamsize)pad);
+
+    if (!out.flush()) {
+        std::cerr << "flip-man-pack: write to '" << argv[1] << "' failed\n";
+        return 1;
+    }
+    std::cout << "flip-man-pack: " << inputs.size() << " assets, " << header.fileSize / 1024
+              << " KiB -> " << argv[1] << "\n";
+    return 0;
+}